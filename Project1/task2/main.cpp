@@ -1,7 +1,8 @@
-#include "engine.h"
+#include "battle_engine.h"
 #include "player.h"
 #include "strategy.h"
-#include "slime.h"
+#include "roster.h"
+#include "rules.h"
 #include <iostream>
 
 int main()
@@ -9,21 +10,18 @@ int main()
     HumanStrategy *humanStrategy = new HumanStrategy();
     GreedyAIStrategy *enemyStrategy = new GreedyAIStrategy();
 
-    Player human(humanStrategy);
-    Player ai(enemyStrategy);
+    BattleArena arena;
+    Player human(humanStrategy, arena);
+    Player ai(enemyStrategy, arena);
 
-    human.addSlime(new Slime("Green", SlimeType::Grass, 110, 10, 10, 10));
-    human.addSlime(new Slime("Red", SlimeType::Fire, 100, 11, 10, 11));
-    human.addSlime(new Slime("Blue", SlimeType::Water, 100, 10, 11, 9));
+    addStandardSlimes(human);
+    addStandardSlimes(ai);
 
-    ai.addSlime(new Slime("Green", SlimeType::Grass, 110, 10, 10, 10));
-    ai.addSlime(new Slime("Red", SlimeType::Fire, 100, 11, 10, 11));
-    ai.addSlime(new Slime("Blue", SlimeType::Water, 100, 10, 11, 9));
-
-    Engine engine(human, ai);
+    // the engine, slimes and strategies are task 3's, only the rules differ, and the turns run the code compiled for them
+    BattleEngine<HumanStrategy, GreedyAIStrategy, Task2Rules> engine(human, ai);
 
     engine.startGame();
     engine.runGame();
 
     return 0;
-}
\ No newline at end of file
+}
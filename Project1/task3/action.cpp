@@ -1,5 +1,7 @@
 #include "action.h"
 
+Action::Action() : Action(ActionType::UseSkill, 0, 0) {}
+
 Action::Action(ActionType type, int index, int priority) : type(type), index(index), priority(priority) {}
 
 ActionType Action::getType() const { return type; }
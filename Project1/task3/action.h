@@ -20,6 +20,11 @@ enum class ActionType
 class Action
 {
 public:
+    /**
+     * @brief Constructs a default Action (using the first skill), so actions can be kept in plain arrays.
+     */
+    Action();
+
     /**
      * @brief Constructs a new Action.
      * @param type The type of the action (UseSkill or ChangeSlime).
@@ -0,0 +1,68 @@
+// Replaces the global operator new and operator delete to count allocations with AllocationTracker.
+// Only linked into the programs that report allocations, the others keep the standard allocator.
+#include "allocation.h"
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Allocates and counts a block, as the standard operator new does.
+ */
+static void *allocate(size_t bytes)
+{
+    AllocationTracker::recordAllocation(bytes);
+    void *pointer = std::malloc(bytes ? bytes : 1);
+    if (!pointer)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+/**
+ * @brief Frees and counts a block.
+ */
+static void deallocate(void *pointer) noexcept
+{
+    if (pointer)
+    {
+        AllocationTracker::recordFree();
+        std::free(pointer);
+    }
+}
+
+// marks the tracker as hooked before main runs
+static const bool installed = (AllocationTracker::markHooked(), true);
+
+void *operator new(size_t bytes) { return allocate(bytes); }
+void *operator new[](size_t bytes) { return allocate(bytes); }
+
+void *operator new(size_t bytes, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(bytes);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(bytes);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void *pointer) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { deallocate(pointer); }
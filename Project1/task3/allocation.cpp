@@ -0,0 +1,54 @@
+#include "allocation.h"
+
+// thread_local data of trivial types needs no constructor, so counting can run inside operator new itself
+static bool hooked = false;
+static thread_local AllocationPhase currentPhase = AllocationPhase::Setup;
+static thread_local AllocationStats threadStats[static_cast<int>(AllocationPhase::Count)];
+
+void AllocationStats::add(const AllocationStats &other)
+{
+    allocations += other.allocations;
+    bytes += other.bytes;
+    frees += other.frees;
+}
+
+bool AllocationTracker::isHooked() { return hooked; }
+
+void AllocationTracker::markHooked() { hooked = true; }
+
+void AllocationTracker::setPhase(AllocationPhase phase) { currentPhase = phase; }
+
+AllocationStats AllocationTracker::getStats(AllocationPhase phase) { return threadStats[static_cast<int>(phase)]; }
+
+void AllocationTracker::reset()
+{
+    for (AllocationStats &stats : threadStats)
+    {
+        stats = AllocationStats();
+    }
+}
+
+void AllocationTracker::recordAllocation(size_t bytes)
+{
+    AllocationStats &stats = threadStats[static_cast<int>(currentPhase)];
+    stats.allocations++;
+    stats.bytes += static_cast<long long>(bytes);
+}
+
+void AllocationTracker::recordFree() { threadStats[static_cast<int>(currentPhase)].frees++; }
+
+void AllocationTracker::print(std::ostream &out, const AllocationStats *stats, long long games)
+{
+    static const char *phaseNames[] = {"setup", "game", "teardown"};
+    if (!hooked)
+    {
+        out << "Allocations are not counted, the allocation hook is not linked in\n";
+        return;
+    }
+    double divisor = games > 0 ? static_cast<double>(games) : 1.0;
+    for (int p = 0; p < static_cast<int>(AllocationPhase::Count); ++p)
+    {
+        out << "Allocations per game, " << phaseNames[p] << ": " << stats[p].allocations / divisor << " ("
+            << stats[p].bytes / divisor << " bytes), frees: " << stats[p].frees / divisor << "\n";
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+/**
+ * @enum AllocationPhase
+ * @brief The phases of a game that allocations are counted in.
+ */
+enum class AllocationPhase
+{
+    Setup,    ///< Building the players and the engine, up to the end of startGame
+    Game,     ///< runGame, the part that should not allocate
+    Teardown, ///< Reading the result and destroying the game
+    Count     ///< Number of phases
+};
+
+/**
+ * @brief Allocation counts of one phase.
+ */
+struct AllocationStats
+{
+    long long allocations = 0; /**< Calls to operator new */
+    long long bytes = 0;       /**< Bytes requested from operator new */
+    long long frees = 0;       /**< Calls to operator delete with a non-null pointer */
+
+    /**
+     * @brief Adds the counts of another phase or thread.
+     * @param other The counts to add.
+     */
+    void add(const AllocationStats &other);
+};
+
+/**
+ * @class AllocationTracker
+ * @brief Counts heap allocations per phase for the calling thread.
+ *
+ * The counts come from the global operator new and operator delete replacements in
+ * alloc_hook.cpp, which only the programs that want them link in. Without the hook the
+ * tracker simply counts nothing, which isHooked tells apart from a program that does not allocate.
+ * Every thread has its own counts and its own current phase, so counting costs no synchronization.
+ */
+class AllocationTracker
+{
+public:
+    /**
+     * @brief Checks whether the allocation hook is linked into the program.
+     * @return true if allocations are counted, false otherwise.
+     */
+    static bool isHooked();
+
+    /**
+     * @brief Sets the phase the calling thread's allocations are counted in.
+     * @param phase The new phase.
+     */
+    static void setPhase(AllocationPhase phase);
+
+    /**
+     * @brief Gets the calling thread's counts for a phase.
+     * @param phase The phase.
+     * @return The counts since the last reset.
+     */
+    static AllocationStats getStats(AllocationPhase phase);
+
+    /**
+     * @brief Sets the calling thread's counts of every phase back to zero.
+     */
+    static void reset();
+
+    /**
+     * @brief Prints the counts of every phase divided by a number of games.
+     * @param out The stream to print to.
+     * @param stats The counts of each phase, indexed by AllocationPhase.
+     * @param games The number of games the counts cover.
+     */
+    static void print(std::ostream &out, const AllocationStats *stats, long long games);
+
+    /**
+     * @brief Called by the hook for every allocation.
+     * @param bytes The requested size.
+     */
+    static void recordAllocation(size_t bytes);
+
+    /**
+     * @brief Called by the hook for every free of a non-null pointer.
+     */
+    static void recordFree();
+
+    /**
+     * @brief Called once by the hook when the program starts.
+     */
+    static void markHooked();
+};
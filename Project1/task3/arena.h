@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "battle_state.h"
+#include "slime.h"
+
+/**
+ * @class BattleArena
+ * @brief Bump allocator holding the mutable data of one battle, such as both players' rosters.
+ *
+ * Objects are laid out one after another in a buffer inside the arena itself, so the two rosters of a
+ * battle sit next to each other in a few cache lines and creating them never touches the heap.
+ * Nothing is freed one by one: reset gives the whole buffer back at once, which is why only trivially
+ * destructible types can be placed in an arena, and tearing a battle down is that single reset.
+ * The arena must outlive everything allocated from it.
+ */
+class BattleArena
+{
+public:
+    static constexpr size_t kCapacity = 2 * kMaxTeamSize * sizeof(Slime); /**< Bytes available to one battle: two full rosters */
+
+    /**
+     * @brief Allocates uninitialized storage for an array.
+     * @tparam T The element type, trivially destructible.
+     * @param count Number of elements.
+     * @return The first element, suitably aligned for T.
+     * @throws std::length_error if the arena has not enough room left.
+     */
+    template <typename T>
+    T *allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+        size_t offset = (used + alignof(T) - 1) / alignof(T) * alignof(T);
+        if (offset > kCapacity || count > (kCapacity - offset) / sizeof(T))
+        {
+            throw std::length_error("battle arena is full");
+        }
+        used = offset + count * sizeof(T);
+        return reinterpret_cast<T *>(buffer + offset);
+    }
+
+    /**
+     * @brief Gives back everything allocated, for the next battle.
+     * @details Whatever was allocated before must no longer be used.
+     */
+    void reset() { used = 0; }
+
+    /**
+     * @brief Gets the number of bytes in use.
+     * @return The bytes allocated since the last reset, alignment padding included.
+     */
+    size_t getUsed() const { return used; }
+
+private:
+    alignas(std::max_align_t) unsigned char buffer[kCapacity]; /**< The storage handed out */
+    size_t used = 0;                                            /**< Bytes handed out so far */
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include "engine.h"
+#include "strategy.h"
+#include "rules.h"
+#include "trace.h"
+
+/**
+ * @class BattleEngine
+ * @brief Engine whose game loop calls both strategies and the turn code of its rules without virtual dispatch.
+ *
+ * The strategy types are template parameters, so every turn's chooseAction calls are qualified
+ * calls the compiler can inline into the loop, instead of going through Player and the Strategy
+ * vtable. The rule set is one too, so the loop calls the turn code compiled for it directly, with
+ * the potion branches left out under the task 1 and task 2 rules. Everything else (forced
+ * replacements, observers, undo) is the Engine's, and the games play exactly as with an Engine
+ * set to the same rules. Only runGame is specialized: called through an Engine reference it runs
+ * the virtual game loop. Decisions are only timed by the Engine's loop, so with a profiler set
+ * runGame falls back to it.
+ *
+ * @tparam P The type of the player's strategy, e.g. GreedyAIStrategy.
+ * @tparam E The type of the enemy's strategy, e.g. PotionGreedyAIStrategy.
+ * @tparam Rules The rule set of the games, see rules.h, set by the constructor.
+ */
+template <typename P, typename E, typename Rules = Task3Rules>
+class BattleEngine : public Engine
+{
+public:
+    /**
+     * @brief Constructs a new BattleEngine that prints the battle to std::cout, as in the interactive game.
+     * @param player The player, its strategy must be a P.
+     * @param enemy The opponent, its strategy must be an E.
+     * @throws std::bad_cast if a player's strategy is not of the engine's strategy type.
+     */
+    BattleEngine(Player &player, Player &enemy)
+        : Engine(player, enemy), playerStrategy(dynamic_cast<P &>(*player.getStrategy())),
+          enemyStrategy(dynamic_cast<E &>(*enemy.getStrategy()))
+    {
+        setRules<Rules>();
+    }
+
+    /**
+     * @brief Constructs a new BattleEngine that reports the battle to the given observer.
+     * @param player The player, its strategy must be a P.
+     * @param enemy The opponent, its strategy must be an E.
+     * @param observer The observer receiving the battle events.
+     * @throws std::bad_cast if a player's strategy is not of the engine's strategy type.
+     */
+    BattleEngine(Player &player, Player &enemy, BattleObserver &observer)
+        : Engine(player, enemy, observer), playerStrategy(dynamic_cast<P &>(*player.getStrategy())),
+          enemyStrategy(dynamic_cast<E &>(*enemy.getStrategy()))
+    {
+        setRules<Rules>();
+    }
+
+    /**
+     * @brief Runs the main game loop until the game is over, as Engine::runGame does.
+     */
+    void runGame()
+    {
+        if (profiler)
+        {
+            Engine::runGame();
+            return;
+        }
+        while (true)
+        {
+            {
+                TRACE_SPAN("Engine::processRound");
+                observer->onRoundStart(round);
+                TRACE_SPAN("Engine::executeTurn");
+                Action playerAction = playerStrategy.P::chooseAction(*this);
+                Action enemyAction = enemyStrategy.E::chooseAction(*this);
+                resolveTurn<Rules>(playerAction, enemyAction);
+            }
+            if (isGameOver())
+            {
+                break;
+            }
+            updateGameState();
+        }
+        displayResults();
+    }
+
+private:
+    P &playerStrategy; /**< The player's strategy, owned by the player */
+    E &enemyStrategy;  /**< The enemy's strategy, owned by the enemy */
+};
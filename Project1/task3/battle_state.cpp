@@ -0,0 +1,109 @@
+#include "battle_state.h"
+#include "engine.h"
+#include "player.h"
+#include <algorithm>
+#include <stdexcept>
+
+template <typename Rules>
+BattleSetup BattleSetup::fromPlayers(const Player &player, const Player &enemy, int criticalChance)
+{
+    BattleSetup setup = {};
+    setup.criticalChance = criticalChance;
+    const Player *players[2] = {&player, &enemy};
+    for (int s = 0; s < 2; ++s)
+    {
+        SlimeList slimes = players[s]->getSlimes();
+        if (slimes.size() > kMaxTeamSize)
+        {
+            throw std::length_error("team is larger than kMaxTeamSize");
+        }
+        if (kFixedTeamSize > 0 && players[s]->getTeamSize() != kFixedTeamSize)
+        {
+            throw std::length_error("team does not have SLIME_TEAM_SIZE slimes");
+        }
+        setup.teamSizes[s] = static_cast<int>(slimes.size());
+        for (size_t i = 0; i < slimes.size(); ++i)
+        {
+            const Slime &slime = slimes[i];
+            SpeciesData &species = setup.species[s][i];
+            species.type = slime.getType();
+            species.maxHP = slime.getMaxHP();
+            // the attack stat is doubled while boosted, the setup keeps the base value
+            species.attack = slime.isAttackBoosted() ? slime.getAttack() / 2 : slime.getAttack();
+            species.defense = slime.getDefense();
+            species.speed = slime.getSpeed();
+            if (slime.getSkills().size() > kMaxSkillCount)
+            {
+                throw std::length_error("slime has more than kMaxSkillCount skills");
+            }
+            species.skillCount = static_cast<int>(slime.getSkills().size());
+            for (int k = 0; k < species.skillCount; ++k)
+            {
+                const Skill &skill = slime.getSkills()[k];
+                species.skills[k] = SkillData{skill.getType(), skill.getPower(), skill.getAccuracy()};
+            }
+        }
+    }
+
+    for (int s = 0; s < 2; ++s)
+    {
+        for (int i = 0; i < setup.teamSizes[s]; ++i)
+        {
+            const SpeciesData &attacker = setup.species[s][i];
+            for (int k = 0; k < attacker.skillCount; ++k)
+            {
+                const SkillData &skill = attacker.skills[k];
+                for (int j = 0; j < setup.teamSizes[1 - s]; ++j)
+                {
+                    const SpeciesData &defender = setup.species[1 - s][j];
+                    for (int boosted = 0; boosted < 2; ++boosted)
+                    {
+                        int attack = boosted ? attacker.attack * 2 : attacker.attack;
+                        setup.damage[s][i][k][j][boosted] = static_cast<int16_t>(
+                            Rules::damage(skill.power, skill.type, attack, defender.defense, defender.type));
+                    }
+                }
+            }
+        }
+    }
+    return setup;
+}
+
+template BattleSetup BattleSetup::fromPlayers<Task1Rules>(const Player &, const Player &, int);
+template BattleSetup BattleSetup::fromPlayers<Task2Rules>(const Player &, const Player &, int);
+template BattleSetup BattleSetup::fromPlayers<Task3Rules>(const Player &, const Player &, int);
+
+BattleState BattleState::fromEngine(const Engine &engine)
+{
+    BattleState state = {};
+    const Player *players[2] = {&engine.getPlayer(), &engine.getEnemy()};
+    for (int s = 0; s < 2; ++s)
+    {
+        SlimeList slimes = players[s]->getSlimes();
+        SideState &side = state.sides[s];
+        for (size_t i = 0; i < slimes.size() && i < kMaxTeamSize; ++i)
+        {
+            side.hp[i] = static_cast<int16_t>(slimes[i].getCurrentHP());
+        }
+        // slimes are stored contiguously, so the active slime's index is its offset; size() before it is chosen
+        Slime *active = players[s]->getActiveSlime();
+        side.active = static_cast<int8_t>(active ? active - slimes.begin() : static_cast<int>(slimes.size()));
+        side.boosted = active && active->isAttackBoosted();
+        for (const Potion &potion : players[s]->getPotions())
+        {
+            if (!potion.isUsed())
+            {
+                if (potion.getType() == Potion::Type::Revival)
+                {
+                    side.revivalPotions++;
+                }
+                else
+                {
+                    side.attackPotions++;
+                }
+            }
+        }
+    }
+    state.round = static_cast<int16_t>(engine.getRound());
+    return state;
+}
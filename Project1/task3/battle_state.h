@@ -0,0 +1,182 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "side.h"
+#include "skill.h"
+#include "slime.h"
+#include "rules.h"
+#include "team_config.h"
+
+class Engine;
+class Player;
+
+constexpr int kMaxTeamSize = kFixedTeamSize > 0 ? kFixedTeamSize : kDynamicMaxTeamSize;       /**< Most slimes a team can have */
+constexpr int kMaxSkillCount = kFixedSkillCount > 0 ? kFixedSkillCount : kDynamicMaxSkillCount; /**< Most skills a slime can have */
+constexpr int kMaxActions = kMaxSkillCount + (kMaxTeamSize - 1) + 2; /**< Most actions a side can choose from in one turn */
+constexpr int kMaxOutcomes = 9; /**< Most chance outcomes of one turn: each side's skill can miss, hit or hit critically */
+
+/**
+ * @brief Index of a side in the per-side arrays of BattleSetup and BattleState.
+ * @param side The side.
+ * @return 0 for the player, 1 for the enemy.
+ */
+constexpr int sideIndex(Side side) { return side == Side::Player ? 0 : 1; }
+
+/**
+ * @brief Gets the side opposing the given one.
+ * @param side The side.
+ * @return The other side.
+ */
+constexpr Side opponentOf(Side side) { return side == Side::Player ? Side::Enemy : Side::Player; }
+
+/**
+ * @brief What became of a side's skill in a turn.
+ */
+enum class HitOutcome : uint8_t
+{
+    Hit,     /**< The skill hit normally */
+    Miss,    /**< The skill missed */
+    Critical /**< The skill hit critically, dealing double damage */
+};
+
+/**
+ * @brief The chance outcome of a turn: what became of each side's skill, ignored for other actions.
+ */
+struct TurnOutcome
+{
+    HitOutcome hits[2] = {HitOutcome::Hit, HitOutcome::Hit}; /**< Outcome of the player's and the enemy's skill */
+};
+
+/**
+ * @brief Static data of a skill, as used by the value-type battle state.
+ */
+struct SkillData
+{
+    SkillType type; /**< The type of the skill */
+    int power;      /**< The power of the skill */
+    int accuracy;   /**< The accuracy of the skill */
+};
+
+/**
+ * @brief Static data of a slime species: everything about a slime that does not change during a battle.
+ */
+struct SpeciesData
+{
+    SlimeType type;                    /**< The type of the slime */
+    int maxHP;                         /**< The maximum hit points of the slime */
+    int attack;                        /**< The unboosted attack stat of the slime */
+    int defense;                       /**< The defense stat of the slime */
+    int speed;                         /**< The speed stat of the slime */
+    int skillCount;                    /**< Number of skills the slime has */
+    SkillData skills[kMaxSkillCount];  /**< The skills of the slime */
+};
+
+/**
+ * @class BattleSetup
+ * @brief The static half of a battle: both teams' species and skills.
+ *
+ * It is built once per battle and shared by every BattleState of that battle, so the
+ * states themselves only carry what changes from turn to turn. Since stats and skills are
+ * fixed for the whole battle, the damage of every possible hit is computed here once,
+ * and turns only look it up.
+ */
+class BattleSetup
+{
+public:
+    /**
+     * @brief Builds the setup from the rosters of two players.
+     * @tparam Rules The rule set whose damage formula fills the damage table, see rules.h.
+     * @param player The human player.
+     * @param enemy The AI opponent.
+     * @param criticalChance Chance in percent that a hit is critical.
+     * @return The static battle data.
+     * @throws std::length_error if a team has more than kMaxTeamSize slimes or a slime more than kMaxSkillCount
+     * skills, or a team does not have SLIME_TEAM_SIZE slimes when the team size is fixed.
+     */
+    template <typename Rules = Task3Rules>
+    static BattleSetup fromPlayers(const Player &player, const Player &enemy, int criticalChance = 0);
+
+    /**
+     * @brief Gets the number of slimes of a side.
+     * @param side The side.
+     * @return The team size of that side.
+     */
+    int getTeamSize(Side side) const { return teamSizes[sideIndex(side)]; }
+
+    /**
+     * @brief Gets the static data of one slime.
+     * @param side The side owning the slime.
+     * @param index The index of the slime in its team.
+     * @return The species data of that slime.
+     */
+    const SpeciesData &getSpecies(Side side, int index) const { return species[sideIndex(side)][index]; }
+
+    /**
+     * @brief Gets the chance that a hit is critical.
+     * @return The chance in percent, 0 when critical hits are off.
+     */
+    int getCriticalChance() const { return criticalChance; }
+
+    /**
+     * @brief Gets the damage of a hit, as computed by Engine::calculateDamage when the battle was set up.
+     * @param attacker The attacking side.
+     * @param attackerIndex The index of the attacking slime in its team.
+     * @param skill The index of the skill used.
+     * @param defenderIndex The index of the defending slime in its team.
+     * @param boosted Whether the attacking slime's attack is boosted.
+     * @return The damage dealt.
+     */
+    int getDamage(Side attacker, int attackerIndex, int skill, int defenderIndex, bool boosted) const
+    {
+        return damage[sideIndex(attacker)][attackerIndex][skill][defenderIndex][boosted];
+    }
+
+private:
+    int teamSizes[2];                       /**< Number of slimes of each side */
+    int criticalChance;                     /**< Chance in percent that a hit is critical */
+    SpeciesData species[2][kMaxTeamSize];   /**< Static data of every slime of each side */
+    int16_t damage[2][kMaxTeamSize][kMaxSkillCount][kMaxTeamSize][2]; /**< Damage of every hit, by attacking side, attacker, skill, defender and boost */
+};
+
+/**
+ * @brief The mutable state of one side of a battle.
+ */
+struct SideState
+{
+    int16_t hp[kMaxTeamSize]; /**< Current HP of every slime of the team */
+    int8_t active;            /**< Index of the active slime */
+    bool boosted;             /**< Whether the active slime's attack is boosted, only the active slime can be */
+    int8_t revivalPotions;    /**< Number of unused revival potions */
+    int8_t attackPotions;     /**< Number of unused attack potions */
+};
+
+/**
+ * @class BattleState
+ * @brief The mutable half of a battle as a flat, trivially-copyable value.
+ *
+ * Copying a state is a plain memcpy of a few dozen bytes, so search and bulk
+ * simulation can snapshot battles freely. The static data lives in BattleSetup,
+ * and the Engine's static turn functions run turns directly on it.
+ */
+struct BattleState
+{
+    SideState sides[2]; /**< State of the player's and the enemy's side */
+    int16_t round;      /**< Current round number */
+
+    /**
+     * @brief Takes a snapshot of the battle run by an engine.
+     * @param engine The engine whose battle is captured, its starting slimes must have been chosen.
+     * @return The state of the battle.
+     */
+    static BattleState fromEngine(const Engine &engine);
+
+    /**
+     * @brief Gets the state of one side.
+     * @param side The side.
+     * @return Reference to the state of that side.
+     */
+    SideState &operator[](Side side) { return sides[sideIndex(side)]; }
+    const SideState &operator[](Side side) const { return sides[sideIndex(side)]; }
+};
+
+static_assert(std::is_trivially_copyable<BattleState>::value, "BattleState must stay a flat value type");
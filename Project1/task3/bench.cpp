@@ -0,0 +1,539 @@
+#include "engine.h"
+#include "battle_engine.h"
+#include "player.h"
+#include "roster.h"
+#include "type_chart.h"
+#include "strategy.h"
+#include "rng.h"
+#include "rules.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+constexpr int kMaxStat = 255;        /**< Highest base stat or skill power the damage check covers */
+constexpr int kMaxAttack = 2 * kMaxStat; /**< Highest attack the damage check covers, a boosted slime's attack is doubled */
+
+/**
+ * @brief One possible hit of a battle.
+ */
+struct Hit
+{
+    Side side;     /**< The attacking side */
+    int attacker;  /**< Index of the attacking slime */
+    int skill;     /**< Index of the skill used */
+    int defender;  /**< Index of the defending slime */
+    bool boosted;  /**< Whether the attacker is boosted */
+};
+
+/**
+ * @brief The original float damage formula, kept as the reference for Engine::calculateDamage.
+ * @details Its result can depend on compiler flags, which is why the engine no longer uses it.
+ */
+static int referenceDamage(int power, SkillType skillType, int attack, int defense, SlimeType defenderType)
+{
+    float effectiveness = TypeChart::effectiveness(skillType, defenderType);
+    float damage = (power * attack / float(defense)) * effectiveness;
+    return std::max(1, static_cast<int>(std::round(damage)));
+}
+
+/**
+ * @brief The float damage formula of task 1 and task 2, kept as the reference for Task1Rules::damage.
+ * @details Unlike the task 3 formula, power * attack / defense is divided in integers before the effectiveness applies.
+ */
+static int referenceTask1Damage(int power, SkillType skillType, int attack, int defense, SlimeType defenderType)
+{
+    float effectiveness = TypeChart::effectiveness(skillType, defenderType);
+    float damage = (power * attack / defense) * effectiveness;
+    return std::max(1, static_cast<int>(std::round(damage)));
+}
+
+/**
+ * @brief Compares a damage formula with its float reference for every combination of stats.
+ * @details The damage only depends on the types through the effectiveness, so one pair of types
+ * per effectiveness value is enough to cover every matchup.
+ * @param label Name of the formula, printed with the result.
+ * @param reference The float reference.
+ * @param formula The formula checked.
+ * @return The number of combinations where the two disagree.
+ */
+template <typename Reference, typename Formula>
+static long long checkFormula(const char *label, Reference reference, Formula formula)
+{
+    const Matchup matchups[] = {{SkillType::Normal, SlimeType::Grass, 2},
+                                {SkillType::Grass, SlimeType::Water, 4},
+                                {SkillType::Grass, SlimeType::Fire, 1}};
+    long long mismatches = 0;
+    long long checked = 0;
+    for (const Matchup &matchup : matchups)
+    {
+        for (int power = 1; power <= kMaxStat; ++power)
+        {
+            for (int attack = 1; attack <= kMaxAttack; ++attack)
+            {
+                for (int defense = 1; defense <= kMaxStat; ++defense)
+                {
+                    int expected = reference(power, matchup.skill, attack, defense, matchup.defender);
+                    int actual = formula(power, matchup.skill, attack, defense, matchup.defender);
+                    if (expected != actual && mismatches++ < 10)
+                    {
+                        std::cerr << label << ", power " << power << ", attack " << attack << ", defense " << defense
+                                  << ", halves " << matchup.halves << ": expected " << expected << ", got " << actual << std::endl;
+                    }
+                    checked++;
+                }
+            }
+        }
+    }
+    std::cout << label << ": checked " << checked << " damage combinations, " << mismatches << " mismatches" << std::endl;
+    return mismatches;
+}
+
+/**
+ * @brief Checks Engine::calculateDamage and Task1Rules::damage against their float references.
+ * @return The number of mismatches of both formulas together.
+ */
+static long long checkDamage()
+{
+    return checkFormula("Engine::calculateDamage", referenceDamage, Engine::calculateDamage) +
+           checkFormula("Task1Rules::damage", referenceTask1Damage, Task1Rules::damage);
+}
+
+/**
+ * @brief Timing summary of one benchmark.
+ */
+struct BenchResult
+{
+    std::string name;     /**< Name of the benchmark */
+    long long iterations; /**< Total number of calls timed */
+    int samples;          /**< Number of timed batches */
+    int batch;            /**< Calls per timed batch */
+    double medianNs;      /**< Median cost of a call over the batches, in nanoseconds */
+    double p99Ns;         /**< 99th percentile cost of a call over the batches, in nanoseconds */
+};
+
+static volatile long long sink; /**< Receives the benchmark checksums, so the work cannot be optimized away */
+
+/**
+ * @brief Times a benchmark body in batches and summarizes the cost per call.
+ * @details Each sample times a batch of calls, so cheap bodies are not drowned by the cost of reading
+ * the clock. The prepare step runs before every batch and is not timed.
+ * @param results Receives the summary.
+ * @param name Name of the benchmark.
+ * @param samples Number of batches.
+ * @param batch Number of calls per batch.
+ * @param prepare Untimed setup, called with the sample number before each batch.
+ * @param body The code to time, called with the call number.
+ * @return The checksum returned by the body, summed.
+ */
+template <typename Prepare, typename Body>
+static long long runBenchmark(std::vector<BenchResult> &results, const char *name, int samples, int batch, Prepare prepare, Body body)
+{
+    long long checksum = 0;
+    long long n = 0;
+    std::vector<double> costs(samples);
+    for (int s = 0; s < samples; ++s)
+    {
+        prepare(s);
+        auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < batch; ++b)
+        {
+            checksum += body(n++);
+        }
+        costs[s] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / batch;
+    }
+    std::sort(costs.begin(), costs.end());
+    size_t p99 = static_cast<size_t>(std::ceil(0.99 * samples)) - 1;
+    results.push_back(BenchResult{name, n, samples, batch, costs[samples / 2], costs[p99]});
+    sink = sink + checksum;
+    return checksum;
+}
+
+/**
+ * @brief Times a benchmark body that needs no setup between batches.
+ */
+template <typename Body>
+static long long runBenchmark(std::vector<BenchResult> &results, const char *name, int samples, int batch, Body body)
+{
+    return runBenchmark(results, name, samples, batch, [](int) {}, body);
+}
+
+/**
+ * @brief Writes the benchmark results as a JSON document.
+ * @param out The stream to write to.
+ * @param results The results, in the order they were run.
+ */
+static void writeJson(std::ostream &out, const std::vector<BenchResult> &results)
+{
+    out << "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult &r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations << ", \"samples\": " << r.samples
+            << ", \"batch\": " << r.batch << ", \"median\": " << r.medianNs << ", \"p99\": " << r.p99Ns
+            << ", \"per_second\": " << (r.medianNs > 0 ? 1e9 / r.medianNs : 0.0) << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}" << std::endl;
+}
+
+/**
+ * @brief Sets up a pair of players the way slime_selfplay does: standard slimes, potions on both sides.
+ */
+static void addStandardTeam(Player &player)
+{
+    addStandardPotions(player);
+    addStandardSlimes(player);
+}
+
+/**
+ * @brief Sets up a player for a rule set: the standard slimes, and the standard potions if the rules have potions.
+ */
+template <typename Rules>
+static void addRulesTeam(Player &player)
+{
+    if constexpr (Rules::kPotions)
+    {
+        addStandardPotions(player);
+    }
+    addStandardSlimes(player);
+}
+
+/**
+ * @brief Times whole games on one battle that is reset before every game, as slime_selfplay plays them.
+ * @tparam EngineType Engine, or the BattleEngine of the two strategies' types and the same rules.
+ * @tparam Rules The rule set the games are played by, see rules.h.
+ * @return The checksum of the games, the sum of their round counts.
+ */
+template <typename EngineType, typename Rules = Task3Rules>
+static long long runResetGames(std::vector<BenchResult> &results, const char *name, int samples, const char *playerName,
+                               const char *enemyName)
+{
+    BattleArena arena;
+    Player player(createStrategy(playerName), arena);
+    Player enemy(createStrategy(enemyName), arena);
+    addRulesTeam<Rules>(player);
+    addRulesTeam<Rules>(enemy);
+    NullObserver observer;
+    Rng rng;
+    EngineType engine(player, enemy, observer);
+    engine.template setRules<Rules>();
+    engine.setRng(rng);
+    return runBenchmark(results, name, samples, 10, [&](long long n)
+                        {
+        rng = Rng(0, static_cast<uint64_t>(n));
+        engine.reset();
+        engine.startGame();
+        engine.runGame();
+        return engine.getRound(); });
+}
+
+/**
+ * @brief Times turns of the state-level engine under a rule set, both sides picking their actions in turn from listActions.
+ * @details Every legal action gets played, switches and potions included when the rules have them, so the
+ * rule sets are compared on the turn code each of them compiles to.
+ * @tparam Rules The rule set, see rules.h.
+ * @return The checksum of the turns, the number of games finished.
+ */
+template <typename Rules>
+static long long runRuleTurns(std::vector<BenchResult> &results, int samples)
+{
+    BattleArena arena;
+    Player player(createStrategy("greedy"), arena);
+    Player enemy(createStrategy("greedy"), arena);
+    addRulesTeam<Rules>(player);
+    addRulesTeam<Rules>(enemy);
+    NullObserver observer;
+    Engine engine(player, enemy, observer);
+    engine.setRules<Rules>();
+    engine.startGame();
+    const BattleSetup &setup = engine.getSetup();
+    const BattleState initial = BattleState::fromEngine(engine);
+
+    BattleState state = initial;
+    std::string name = std::string("Engine::listActions+executeTurn, ") + Rules::kName + " rules";
+    return runBenchmark(results, name.c_str(), samples, 2500, [&](long long n)
+                        {
+        Action actions[kMaxActions];
+        int count = Engine::listActions<Rules>(state, setup, Side::Player, actions);
+        Action playerAction = actions[n % count];
+        count = Engine::listActions<Rules>(state, setup, Side::Enemy, actions);
+        Action enemyAction = actions[n / 3 % count];
+        Engine::executeTurn<Rules>(state, setup, playerAction, enemyAction);
+        if (Engine::isGameOver<Rules>(state))
+        {
+            state = initial;
+            return 1;
+        }
+        state.round++;
+        for (Side side : {Side::Player, Side::Enemy})
+        {
+            if (state[side].hp[state[side].active] == 0)
+            {
+                for (int i = 0; i < setup.getTeamSize(side); ++i)
+                {
+                    if (state[side].hp[i] > 0)
+                    {
+                        Engine::sendSlime(state, side, i);
+                        break;
+                    }
+                }
+            }
+        }
+        return 0; });
+}
+
+/**
+ * @brief Collects varied start-of-turn positions by playing games between randomized and greedy strategies.
+ * @param count Number of positions wanted.
+ * @return The positions, all of the same battle as any standard team setup.
+ */
+static std::vector<BattleState> collectPositions(size_t count)
+{
+    std::vector<BattleState> positions;
+    for (uint64_t game = 0; positions.size() < count; ++game)
+    {
+        BattleArena arena;
+        Player player(createStrategy("simple"), arena);
+        Player enemy(createStrategy("potion-greedy"), arena);
+        addStandardTeam(player);
+        addStandardTeam(enemy);
+        NullObserver observer;
+        Rng rng(0, game);
+        Engine engine(player, enemy, observer);
+        engine.setRng(rng);
+        engine.startGame();
+        while (!engine.isGameOver() && positions.size() < count)
+        {
+            positions.push_back(BattleState::fromEngine(engine));
+            engine.applyTurn(player.chooseAction(engine), enemy.chooseAction(engine));
+        }
+    }
+    return positions;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "--check")
+    {
+        return checkDamage() == 0 ? 0 : 1;
+    }
+
+    int samples = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (samples < 1)
+    {
+        std::cerr << "Usage: " << argv[0] << " [samples | --check]" << std::endl;
+        return 1;
+    }
+    std::vector<BenchResult> results;
+
+    BattleArena arena;
+    Player player(nullptr, arena);
+    Player enemy(nullptr, arena);
+    addStandardTeam(player);
+    addStandardTeam(enemy);
+    BattleSetup setup = BattleSetup::fromPlayers(player, enemy);
+
+    std::vector<Hit> hits;
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        for (int i = 0; i < setup.getTeamSize(side); ++i)
+        {
+            for (int k = 0; k < setup.getSpecies(side, i).skillCount; ++k)
+            {
+                for (int j = 0; j < setup.getTeamSize(opponentOf(side)); ++j)
+                {
+                    hits.push_back(Hit{side, i, k, j, false});
+                    hits.push_back(Hit{side, i, k, j, true});
+                }
+            }
+        }
+    }
+
+    // the same hits in the same order, through the float formula, the integer formula and the battle's damage table
+    const int damageBatch = 10000;
+    long long reference = runBenchmark(results, "referenceDamage", samples, damageBatch, [&](long long n)
+                                       {
+        const Hit &hit = hits[n % hits.size()];
+        const SpeciesData &attacker = setup.getSpecies(hit.side, hit.attacker);
+        const SpeciesData &defender = setup.getSpecies(opponentOf(hit.side), hit.defender);
+        const SkillData &skill = attacker.skills[hit.skill];
+        int attack = hit.boosted ? attacker.attack * 2 : attacker.attack;
+        return referenceDamage(skill.power, skill.type, attack, defender.defense, defender.type); });
+    long long formula = runBenchmark(results, "Engine::calculateDamage", samples, damageBatch, [&](long long n)
+                                     {
+        const Hit &hit = hits[n % hits.size()];
+        const SpeciesData &attacker = setup.getSpecies(hit.side, hit.attacker);
+        const SpeciesData &defender = setup.getSpecies(opponentOf(hit.side), hit.defender);
+        const SkillData &skill = attacker.skills[hit.skill];
+        int attack = hit.boosted ? attacker.attack * 2 : attacker.attack;
+        return Engine::calculateDamage(skill.power, skill.type, attack, defender.defense, defender.type); });
+    long long table = runBenchmark(results, "BattleSetup::getDamage", samples, damageBatch, [&](long long n)
+                                   {
+        const Hit &hit = hits[n % hits.size()];
+        return setup.getDamage(hit.side, hit.attacker, hit.skill, hit.defender, hit.boosted); });
+    if (formula != table || formula != reference)
+    {
+        std::cerr << "The damage paths disagree" << std::endl;
+        return 1;
+    }
+
+    // whole turns on a battle state, both sides using their type skill until the game ends
+    BattleState initial = {};
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        for (int i = 0; i < setup.getTeamSize(side); ++i)
+        {
+            initial[side].hp[i] = static_cast<int16_t>(setup.getSpecies(side, i).maxHP);
+        }
+    }
+    initial[Side::Enemy].active = 1;
+    BattleState state = initial;
+    Action skill(ActionType::UseSkill, 1, 0);
+    runBenchmark(results, "Engine::executeTurn", samples, 2500, [&](long long)
+                 {
+        Engine::executeTurn(state, setup, skill, skill);
+        if (Engine::isGameOver(state))
+        {
+            state = initial;
+            return 1;
+        }
+        for (Side side : {Side::Player, Side::Enemy})
+        {
+            if (state[side].hp[state[side].active] == 0)
+            {
+                for (int i = 0; i < setup.getTeamSize(side); ++i)
+                {
+                    if (state[side].hp[i] > 0)
+                    {
+                        Engine::sendSlime(state, side, i);
+                        break;
+                    }
+                }
+            }
+        }
+        return 0; });
+
+    // the three rule sets side by side, each on the turn code compiled for it
+    runRuleTurns<Task1Rules>(results, samples);
+    runRuleTurns<Task2Rules>(results, samples);
+    runRuleTurns<Task3Rules>(results, samples);
+
+    // the object model: a played position, its turn applied and taken back
+    std::vector<BattleState> positions = collectPositions(samples);
+    {
+        BattleArena arena;
+        Player benchPlayer(createStrategy("greedy"), arena);
+        Player benchEnemy(createStrategy("potion-greedy"), arena);
+        addStandardTeam(benchPlayer);
+        addStandardTeam(benchEnemy);
+        NullObserver observer;
+        Engine engine(benchPlayer, benchEnemy, observer);
+        engine.startGame();
+
+        Action playerAction = skill;
+        Action enemyAction = skill;
+        runBenchmark(results, "Engine::applyTurn+undoTurn", samples, 1000, [&](int s)
+                     {
+            engine.loadState(positions[s % positions.size()]);
+            playerAction = benchPlayer.chooseAction(engine);
+            enemyAction = benchEnemy.chooseAction(engine); },
+                     [&](long long)
+                     {
+            engine.applyTurn(playerAction, enemyAction);
+            engine.undoTurn();
+            return engine.getRound(); });
+
+        runBenchmark(results, "Player::isDefeated", samples, 10000, [&](int s)
+                     { engine.loadState(positions[s % positions.size()]); },
+                     [&](long long)
+                     { return benchEnemy.isDefeated() ? 1 : 0; });
+
+        // the potion is given back after each use, the boost it gave is taken back with it
+        runBenchmark(results, "Player::usePotion", samples, 1000, [&](int s)
+                     { engine.loadState(positions[s % positions.size()]); },
+                     [&](long long)
+                     {
+            Slime *active = benchEnemy.getActiveSlime();
+            bool boosted = active->isAttackBoosted();
+            bool used = benchEnemy.usePotion(Potion::Type::Attack, active);
+            if (used)
+            {
+                benchEnemy.restorePotion(Potion::Type::Attack);
+                if (!boosted)
+                {
+                    active->resetAttackBoost();
+                }
+            }
+            return used ? 1 : 0; });
+    }
+
+    // one decision of each strategy, on positions taken from played games; searching strategies are timed call by call
+    const struct
+    {
+        const char *name;
+        const char *label;
+        int batch;
+    } strategies[] = {{"simple", "SimpleAIStrategy::chooseAction", 1000},
+                      {"greedy", "GreedyAIStrategy::chooseAction", 1000},
+                      {"potion-greedy", "PotionGreedyAIStrategy::chooseAction", 1000},
+                      {"search", "SearchAIStrategy::chooseAction", 1},
+                      {"mcts", "MCTSStrategy::chooseAction", 1}};
+    for (const auto &entry : strategies)
+    {
+        BattleArena arena;
+        Player benchPlayer(createStrategy(entry.name), arena);
+        Player benchEnemy(createStrategy("potion-greedy"), arena);
+        addStandardTeam(benchPlayer);
+        addStandardTeam(benchEnemy);
+        NullObserver observer;
+        Engine engine(benchPlayer, benchEnemy, observer);
+        engine.startGame();
+        runBenchmark(results, entry.label, samples, entry.batch, [&](int s)
+                     { engine.loadState(positions[s % positions.size()]); },
+                     [&](long long)
+                     { return benchPlayer.chooseAction(engine).getIndex(); });
+    }
+
+    // whole games from startGame to the end, as slime_selfplay plays them
+    runBenchmark(results, "game potion-greedy vs greedy", samples, 10, [&](long long n)
+                 {
+        BattleArena arena;
+        Player gamePlayer(createStrategy("potion-greedy"), arena);
+        Player gameEnemy(createStrategy("greedy"), arena);
+        addStandardTeam(gamePlayer);
+        addStandardTeam(gameEnemy);
+        NullObserver observer;
+        Rng rng(0, static_cast<uint64_t>(n));
+        Engine engine(gamePlayer, gameEnemy, observer);
+        engine.setRng(rng);
+        engine.startGame();
+        engine.runGame();
+        return engine.getRound(); });
+
+    // the same games on a reset battle, with the strategies called through Player and the vtable and called directly
+    long long virtualGames = runResetGames<Engine>(results, "game potion-greedy vs greedy, Engine", samples, "potion-greedy", "greedy");
+    long long staticGames = runResetGames<BattleEngine<PotionGreedyAIStrategy, GreedyAIStrategy>>(
+        results, "game potion-greedy vs greedy, BattleEngine", samples, "potion-greedy", "greedy");
+    long long virtualSimple = runResetGames<Engine>(results, "game simple vs simple, Engine", samples, "simple", "simple");
+    long long staticSimple = runResetGames<BattleEngine<SimpleAIStrategy, SimpleAIStrategy>>(
+        results, "game simple vs simple, BattleEngine", samples, "simple", "simple");
+    if (virtualGames != staticGames || virtualSimple != staticSimple)
+    {
+        std::cerr << "Engine and BattleEngine games disagree" << std::endl;
+        return 1;
+    }
+
+    // each task's games under its own rules, the human player replaced by the greedy strategy
+    runResetGames<BattleEngine<GreedyAIStrategy, SimpleAIStrategy, Task1Rules>, Task1Rules>(
+        results, "game task1 rules, greedy vs simple", samples, "greedy", "simple");
+    runResetGames<BattleEngine<GreedyAIStrategy, GreedyAIStrategy, Task2Rules>, Task2Rules>(
+        results, "game task2 rules, greedy vs greedy", samples, "greedy", "greedy");
+    runResetGames<BattleEngine<GreedyAIStrategy, PotionGreedyAIStrategy, Task3Rules>, Task3Rules>(
+        results, "game task3 rules, greedy vs potion-greedy", samples, "greedy", "potion-greedy");
+
+    writeJson(std::cout, results);
+    return 0;
+}
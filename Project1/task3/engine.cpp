@@ -1,26 +1,59 @@
 #include "engine.h"
+#include "profiler.h"
+#include "trace.h"
 #include <iostream>
-#include <cmath>
+#include <algorithm>
 
-Engine::Engine(Player &player, Player &enemy)
-    : player(player), enemy(enemy), round(0), playerActiveSlime(nullptr), enemyActiveSlime(nullptr) {}
+// shared by every engine that prints the battle, the text observer keeps no state of its own
+static TextObserver consoleObserver;
+
+Engine::Engine(Player &player, Player &enemy) : Engine(player, enemy, consoleObserver) {}
+
+Engine::Engine(Player &player, Player &enemy, BattleObserver &observer)
+    : player(player), enemy(enemy), observer(&observer), round(0), playerActiveSlime(nullptr), enemyActiveSlime(nullptr), setup(), ownRng(), rng(&ownRng)
+{
+    player.setSide(Side::Player);
+    enemy.setSide(Side::Enemy);
+    player.setRng(*rng);
+    enemy.setRng(*rng);
+}
+
+void Engine::setObserver(BattleObserver &observer) { this->observer = &observer; }
+
+void Engine::setCriticalChance(int percent) { criticalChance = percent; }
+
+void Engine::setRng(Rng &rng)
+{
+    this->rng = &rng;
+    player.setRng(rng);
+    enemy.setRng(rng);
+}
+
+void Engine::setProfiler(DecisionProfiler &profiler)
+{
+    this->profiler = &profiler;
+    player.setProfiler(&profiler);
+    enemy.setProfiler(&profiler);
+}
 
 void Engine::startGame()
 {
-    std::cout << "Welcome to Battle of Slimes!" << std::endl;
-    std::cout << "You have Green, Red and Blue. So does Enemy." << std::endl;
+    observer->onGameStart();
+
+    // stats and skills never change during a battle, so every hit's damage is computed once here
+    setup = withRules(rules, [&](auto ruleSet)
+                      { return BattleSetup::fromPlayers<decltype(ruleSet)>(player, enemy, criticalChance); });
 
-    playerActiveSlime = player.chooseStartingSlime(*this);
-    enemyActiveSlime = enemy.chooseStartingSlime(*this);
+    playerActiveSlime = &player.getSlimes()[player.chooseStartingSlime(*this)];
+    enemyActiveSlime = &enemy.getSlimes()[enemy.chooseStartingSlime(*this)];
 
-    std::cout << "You start with " << playerActiveSlime->getName() << std::endl;
-    std::cout << "Enemy starts with " << enemyActiveSlime->getName() << std::endl;
+    observer->onStartingSlimes(*playerActiveSlime, *enemyActiveSlime);
 
     player.setActiveSlime(playerActiveSlime);
     enemy.setActiveSlime(enemyActiveSlime);
     updateGameState();
 
-    std::cout << "Battle starts!" << std::endl;
+    observer->onBattleStart();
 }
 
 void Engine::runGame()
@@ -35,16 +68,48 @@ void Engine::runGame()
         updateGameState();
     }
     displayResults();
+    if (profiler)
+    {
+        profiler->onGameEnd();
+    }
+}
+
+void Engine::reset()
+{
+    player.reset();
+    enemy.reset();
+    round = 0;
+    playerActiveSlime = nullptr;
+    enemyActiveSlime = nullptr;
+    journaling = false;
+    journal.clear();
+    turnStarts.clear();
 }
 
 bool Engine::isGameOver() const
 {
-    return player.isDefeated() || enemy.isDefeated() || round >= 100;
+    return player.isDefeated() || enemy.isDefeated() || round >= roundLimit;
+}
+
+GameResult Engine::getResult() const
+{
+    if (player.isDefeated())
+    {
+        return GameResult::Lose;
+    }
+    else if (enemy.isDefeated())
+    {
+        return GameResult::Win;
+    }
+    return GameResult::Draw;
 }
 
+RuleSet Engine::getRules() const { return rules; }
 int Engine::getRound() const { return round; }
 const Player &Engine::getPlayer() const { return player; }
 const Player &Engine::getEnemy() const { return enemy; }
+const BattleSetup &Engine::getSetup() const { return setup; }
+uint64_t Engine::getHash() const { return player.getHash() ^ enemy.getHash(); }
 Slime *Engine::getPlayerActiveSlime() const { return playerActiveSlime; }
 Slime *Engine::getEnemyActiveSlime() const { return enemyActiveSlime; }
 
@@ -54,27 +119,45 @@ void Engine::updateGameState()
     displayStatus();
 }
 
+Side Engine::sideOf(const Player &p) const
+{
+    return &p == &player ? Side::Player : Side::Enemy;
+}
+
 void Engine::processRound()
 {
-    std::cout << "------------------------------------" << std::endl;
-    std::cout << "Round " << round << std::endl;
+    TRACE_SPAN("Engine::processRound");
+    observer->onRoundStart(round);
     executeTurn();
 }
 
 void Engine::executeTurn()
 {
+    TRACE_SPAN("Engine::executeTurn");
     Action playerAction = player.chooseAction(*this);
     Action enemyAction = enemy.chooseAction(*this);
+    resolveTurn(playerAction, enemyAction);
+}
+
+void Engine::resolveTurn(const Action &playerAction, const Action &enemyAction)
+{
+    // one branch per turn, the turn itself runs the code compiled for the rule set
+    withRules(rules, [&](auto ruleSet)
+              { resolveTurn<decltype(ruleSet)>(playerAction, enemyAction); });
+}
 
+template <typename Rules>
+void Engine::resolveTurn(const Action &playerAction, const Action &enemyAction)
+{
     bool isNextMoveSlimeKilled = false;
 
     // if player's action has higher priority, execute player's action first
     if (playerAction.getPriority() > enemyAction.getPriority())
     {
-        isNextMoveSlimeKilled = executeAction(player, enemy, playerAction);
+        isNextMoveSlimeKilled = executeAction<Rules>(player, enemy, playerAction);
         if (!isNextMoveSlimeKilled)
         {
-            executeAction(enemy, player, enemyAction);
+            executeAction<Rules>(enemy, player, enemyAction);
         }
     }
     // if player's action has the same priority as enemy's action
@@ -82,10 +165,10 @@ void Engine::executeTurn()
     {
         // if player and enemy choose to change their slime, both actions are executed at the same time, so no one knows the other one's next slime.
         // in order to display player's info before enemy's, execute player's action first
-        isNextMoveSlimeKilled = executeAction(player, enemy, playerAction);
+        isNextMoveSlimeKilled = executeAction<Rules>(player, enemy, playerAction);
         if (!isNextMoveSlimeKilled)
         {
-            executeAction(enemy, player, enemyAction);
+            executeAction<Rules>(enemy, player, enemyAction);
         }
     }
     else if (playerAction.getPriority() == enemyAction.getPriority())
@@ -93,97 +176,101 @@ void Engine::executeTurn()
         // if player and enemy choose to use skill, the one with higher speed will execute the action first
         if (player.getActiveSlime()->getSpeed() > enemy.getActiveSlime()->getSpeed())
         {
-            isNextMoveSlimeKilled = executeAction(player, enemy, playerAction);
+            isNextMoveSlimeKilled = executeAction<Rules>(player, enemy, playerAction);
             if (!isNextMoveSlimeKilled)
             {
-                executeAction(enemy, player, enemyAction);
+                executeAction<Rules>(enemy, player, enemyAction);
             }
         }
         // if player's action is the same priority as enemy's action, but enemy's slime has higher or equal speed, execute enemy's action first
         else
         {
-            isNextMoveSlimeKilled = executeAction(enemy, player, enemyAction);
+            isNextMoveSlimeKilled = executeAction<Rules>(enemy, player, enemyAction);
             if (!isNextMoveSlimeKilled)
             {
-                executeAction(player, enemy, playerAction);
+                executeAction<Rules>(player, enemy, playerAction);
             }
         }
     }
     // if enemy's action has higher priority, execute enemy's action first
     else
     {
-        isNextMoveSlimeKilled = executeAction(enemy, player, enemyAction);
+        isNextMoveSlimeKilled = executeAction<Rules>(enemy, player, enemyAction);
         if (!isNextMoveSlimeKilled)
         {
-            executeAction(player, enemy, playerAction);
+            executeAction<Rules>(player, enemy, playerAction);
         }
     }
 }
 
+template <typename Rules>
 bool Engine::executeAction(Player &attacker, Player &defender, const Action &action)
 {
     switch (action.getType())
     {
     case ActionType::UseSkill:
     {
+        TRACE_SPAN("Engine::executeAction", "UseSkill");
         Slime *attackerSlime = attacker.getActiveSlime();
         Slime *defenderSlime = defender.getActiveSlime();
         const Skill &skill = attackerSlime->getSkills()[action.getIndex()];
 
-        int damage = calculateDamage(*attackerSlime, *defenderSlime, skill);
-        defenderSlime->takeDamage(damage);
+        // the rolls are only made when they can fail, so battles without misses and critical hits draw no random numbers
+        if (skill.getAccuracy() < 100 && static_cast<int>(rng->uniformInt(100)) >= skill.getAccuracy())
+        {
+            observer->onSkillMissed(sideOf(attacker), *attackerSlime, skill);
+            break;
+        }
+        bool critical = setup.getCriticalChance() > 0 && static_cast<int>(rng->uniformInt(100)) < setup.getCriticalChance();
 
-        if (&attacker == &player)
+        int damage = setup.getDamage(sideOf(attacker), attackerSlime->getSlot(), action.getIndex(),
+                                     defenderSlime->getSlot(), attackerSlime->isAttackBoosted());
+        if (critical)
         {
-            // if player is the attacker
-            std::cout << "Your ";
+            damage *= 2;
         }
-        else
+        record(JournalEntry::Kind::HP, &defender, defenderSlime, defenderSlime->getCurrentHP());
+        defenderSlime->takeDamage(damage);
+
+        observer->onSkillUsed(sideOf(attacker), *attackerSlime, skill, damage);
+        if (critical)
         {
-            // if enemy is the attacker
-            std::cout << "Enemy's ";
+            observer->onCriticalHit(sideOf(attacker), *attackerSlime);
         }
-        std::cout << attackerSlime->getName() << " uses " << skill.getName() << "! Damage: " << damage << std::endl;
 
         if (defenderSlime->isDefeated())
         {
             // remove the attack potion if the slime is killed
-            defenderSlime->resetAttackBoost();
-            if (&defender == &player)
+            if constexpr (Rules::kPotions)
             {
-                // if player is the defender
-                std::cout << "Your ";
+                record(JournalEntry::Kind::Boost, &defender, defenderSlime, defenderSlime->isAttackBoosted());
+                defenderSlime->resetAttackBoost();
             }
-            else
-            {
-                // if enemy is the defender
-                std::cout << "Enemy's ";
-            }
-            std::cout << defenderSlime->getName() << " is beaten" << std::endl;
+            observer->onSlimeBeaten(sideOf(defender), *defenderSlime);
 
             // if the last slime is killed and the game is not over, the player should choose the next slime
             if (isGameOver())
             {
                 return true; // go back to executeTurn() and display the result
             }
-            Slime *nextSlime = defender.chooseNextSlime(*this);
+            int nextIndex = defender.chooseNextSlime(*this);
 
-            if (nextSlime)
+            if (nextIndex >= 0)
             {
+                Slime *nextSlime = &defender.getSlimes()[nextIndex];
+                record(JournalEntry::Kind::Active, &defender, defender.getActiveSlime(), 0);
                 defender.setActiveSlime(nextSlime);
                 if (&defender == &player)
                 {
                     // if player is the defender
                     setActiveSlimes(nextSlime, enemyActiveSlime);
-                    std::cout << "You send ";
                 }
                 else
                 {
                     // if enemy is the defender
                     setActiveSlimes(playerActiveSlime, nextSlime);
-                    std::cout << "Enemy sends ";
                 }
-                std::cout << defender.getActiveSlime()->getName() << std::endl;
+                observer->onSlimeSent(sideOf(defender), *defender.getActiveSlime());
             }
 
             return true; // a forced change of slime means that the opponent's current slime is killed and this should forbid that player (either attacker or defender) from using skill
@@ -192,111 +279,449 @@ bool Engine::executeAction(Player &attacker, Player &defender, const Action &act
     }
     case ActionType::ChangeSlime:
     {
+        TRACE_SPAN("Engine::executeAction", "ChangeSlime");
         Slime *currentActiveSlime = attacker.getActiveSlime();
-        Slime *newSlime = attacker.getSlimes()[action.getIndex()];
+        Slime *newSlime = &attacker.getSlimes()[action.getIndex()];
         // remove attack potion if the slime is changed
-        if (currentActiveSlime->isAttackBoosted() == true)
+        if constexpr (Rules::kPotions)
         {
-            std::cout << currentActiveSlime->getName() << " is no longer boosted!" << std::endl;
-            currentActiveSlime->resetAttackBoost();
+            if (currentActiveSlime->isAttackBoosted() == true)
+            {
+                observer->onBoostRemoved(sideOf(attacker), *currentActiveSlime);
+                record(JournalEntry::Kind::Boost, &attacker, currentActiveSlime, true);
+                currentActiveSlime->resetAttackBoost();
+            }
         }
 
+        record(JournalEntry::Kind::Active, &attacker, currentActiveSlime, 0);
         attacker.setActiveSlime(newSlime);
 
         if (&attacker == &player)
         {
             setActiveSlimes(newSlime, enemyActiveSlime);
-            std::cout << "You send ";
         }
         else
         {
             setActiveSlimes(playerActiveSlime, newSlime);
-            std::cout << "Enemy sends ";
         }
-        std::cout << attacker.getActiveSlime()->getName() << std::endl;
+        observer->onSlimeSent(sideOf(attacker), *attacker.getActiveSlime());
         break;
     }
     case ActionType::UsePotion:
     {
-        Slime *enemyActiveSlime = attacker.getActiveSlime(); // This holds because in task 3, only enemy has potions to use
-        // 0 stands for Revival potion, 1 stands for Attack potion
-        if (action.getIndex() == 0)
+        // under rules without potions a potion action does nothing
+        if constexpr (Rules::kPotions)
         {
-            std::cout << "Enemy uses Revival Potion" << std::endl;
-            // find the inactive enemy's slime that is defeated and revive it
-            enemy.usePotion(Potion::Type::Revival, nullptr); // This holds because in task 3, only enemy has potions to use
+            TRACE_SPAN("Engine::executeAction", "UsePotion");
+            // in task 3 only the enemy has potions, but in bot-vs-bot games either side may use them
+            Slime *attackerActiveSlime = attacker.getActiveSlime();
+            // 0 stands for Revival potion, 1 stands for Attack potion
+            if (action.getIndex() == 0)
+            {
+                observer->onPotionUsed(sideOf(attacker), Potion::Type::Revival, nullptr);
+                bool hasPotion = attacker.canUseRevivalPotion();
+                if (hasPotion)
+                {
+                    // the potion revives the first beaten slime, any of them may change
+                    for (Slime &slime : attacker.getSlimes())
+                    {
+                        if (slime.isDefeated())
+                        {
+                            record(JournalEntry::Kind::HP, &attacker, &slime, 0);
+                        }
+                    }
+                    record(JournalEntry::Kind::Potion, &attacker, nullptr, static_cast<int>(Potion::Type::Revival));
+                }
+                // find the inactive slime that is defeated and revive it
+                if (!attacker.usePotion(Potion::Type::Revival, nullptr) && hasPotion)
+                {
+                    observer->onNothingToRevive(sideOf(attacker));
+                }
+            }
+            else if (action.getIndex() == 1)
+            {
+                observer->onPotionUsed(sideOf(attacker), Potion::Type::Attack, attackerActiveSlime);
+                if (attacker.canUseAttackPotion())
+                {
+                    record(JournalEntry::Kind::Boost, &attacker, attackerActiveSlime, attackerActiveSlime->isAttackBoosted());
+                    record(JournalEntry::Kind::Potion, &attacker, nullptr, static_cast<int>(Potion::Type::Attack));
+                }
+                attacker.usePotion(Potion::Type::Attack, attackerActiveSlime);
+            }
+            else
+            {
+                std::cerr << "Invalid action index for action of type UsePotion" << std::endl;
+            }
         }
-        else if (action.getIndex() == 1)
+        break;
+    }
+    }
+    return false;
+}
+
+void Engine::applyTurn(const Action &playerAction, const Action &enemyAction)
+{
+    turnStarts.push_back(journal.size());
+    journaling = true;
+    resolveTurn(playerAction, enemyAction);
+    // advance the round as runGame does between rounds
+    if (!isGameOver())
+    {
+        record(JournalEntry::Kind::Round, nullptr, nullptr, round);
+        round++;
+    }
+    journaling = false;
+}
+
+void Engine::loadState(const BattleState &state)
+{
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        Player &owner = side == Side::Player ? player : enemy;
+        const SideState &own = state[side];
+        for (Slime &slime : owner.getSlimes())
         {
-            std::cout << "Enemy uses Attack Potion on " << enemyActiveSlime->getName() << std::endl;
-            // enemyActiveSlime->boostAttack();
-            enemy.usePotion(Potion::Type::Attack, enemyActiveSlime);
+            slime.restoreHP(own.hp[slime.getSlot()]);
+            slime.resetAttackBoost();
         }
-        else
+        Slime *active = &owner.getSlimes()[own.active];
+        if (own.boosted)
         {
-            std::cerr << "Invalid action index for action of type UsePotion" << std::endl;
+            active->boostAttack();
         }
-        break;
+        owner.setActiveSlime(active);
+        owner.setUnusedPotions(Potion::Type::Revival, own.revivalPotions);
+        owner.setUnusedPotions(Potion::Type::Attack, own.attackPotions);
+    }
+    setActiveSlimes(player.getActiveSlime(), enemy.getActiveSlime());
+    round = state.round;
+    journal.clear();
+    turnStarts.clear();
+}
+
+void Engine::undoTurn()
+{
+    if (turnStarts.empty())
+    {
+        return;
     }
+    size_t start = turnStarts.back();
+    turnStarts.pop_back();
+
+    // newest change first, so a value changed twice ends up at its oldest recorded value
+    while (journal.size() > start)
+    {
+        const JournalEntry &entry = journal.back();
+        switch (entry.kind)
+        {
+        case JournalEntry::Kind::HP:
+            entry.slime->restoreHP(entry.value);
+            break;
+        case JournalEntry::Kind::Boost:
+            if (entry.value)
+            {
+                entry.slime->boostAttack();
+            }
+            else
+            {
+                entry.slime->resetAttackBoost();
+            }
+            break;
+        case JournalEntry::Kind::Active:
+            entry.owner->setActiveSlime(entry.slime);
+            if (entry.owner == &player)
+            {
+                setActiveSlimes(entry.slime, enemyActiveSlime);
+            }
+            else
+            {
+                setActiveSlimes(playerActiveSlime, entry.slime);
+            }
+            break;
+        case JournalEntry::Kind::Potion:
+            entry.owner->restorePotion(static_cast<Potion::Type>(entry.value));
+            break;
+        case JournalEntry::Kind::Round:
+            round = entry.value;
+            break;
+        }
+        journal.pop_back();
     }
-    return false;
 }
 
-int Engine::calculateDamage(const Slime &attacker, const Slime &defender, const Skill &skill)
+void Engine::record(JournalEntry::Kind kind, Player *owner, Slime *slime, int value)
 {
-    float effectiveness = getTypeEffectiveness(skill.getType(), defender.getType());
-    float damage = (skill.getPower() * attacker.getAttack() / float(defender.getDefense())) * effectiveness;
-    // NOTE: we don't multiply damage by 2 here for attack potion, because the logic is that if a slime is boosted by attack potion, its attack will be doubled
-    return std::max(1, static_cast<int>(std::round(damage)));
+    if (journaling)
+    {
+        journal.push_back(JournalEntry{kind, owner, slime, value});
+    }
 }
 
-float Engine::getTypeEffectiveness(SkillType attackType, SlimeType defenderType)
+int Engine::calculateDamage(int power, SkillType skillType, int attack, int defense, SlimeType defenderType)
 {
-    if (attackType == SkillType::Grass && defenderType == SlimeType::Water)
-        return 2.0f;
-    if (attackType == SkillType::Fire && defenderType == SlimeType::Grass)
-        return 2.0f;
-    if (attackType == SkillType::Water && defenderType == SlimeType::Fire)
-        return 2.0f;
-    if (attackType == SkillType::Grass && defenderType == SlimeType::Fire)
-        return 0.5f;
-    if (attackType == SkillType::Fire && defenderType == SlimeType::Water)
-        return 0.5f;
-    if (attackType == SkillType::Water && defenderType == SlimeType::Grass)
-        return 0.5f;
-    if (attackType == SkillType::Grass && defenderType == SlimeType::Grass)
-        return 0.5f;
-    if (attackType == SkillType::Fire && defenderType == SlimeType::Fire)
-        return 0.5f;
-    if (attackType == SkillType::Water && defenderType == SlimeType::Water)
-        return 0.5f;
-    return 1.0f;
+    // power * attack * effectiveness / defense rounded half up, with the effectiveness in halves:
+    // all in integers, so every compiler and every set of flags gives the same damage
+    return Task3Rules::damage(power, skillType, attack, defense, defenderType);
 }
 
 void Engine::displayStatus() const
 {
-    std::cout << "Your " << playerActiveSlime->getName() << ": HP " << playerActiveSlime->getCurrentHP() << " || Enemy's " << enemyActiveSlime->getName() << ": HP " << enemyActiveSlime->getCurrentHP() << std::endl;
-    return;
+    observer->onStatus(*playerActiveSlime, *enemyActiveSlime);
 }
 
 void Engine::displayResults() const
 {
-    if (player.isDefeated())
+    observer->onGameEnd(getResult());
+}
+
+template <typename Rules>
+bool Engine::executeTurn(BattleState &state, const BattleSetup &setup, const Action &playerAction, const Action &enemyAction)
+{
+    return executeTurn<Rules>(state, setup, playerAction, enemyAction, TurnOutcome());
+}
+
+template <typename Rules>
+bool Engine::executeTurn(BattleState &state, const BattleSetup &setup, const Action &playerAction, const Action &enemyAction,
+                         const TurnOutcome &outcome)
+{
+    // same ordering rules as the object-based executeTurn
+    bool playerFirst;
+    if (playerAction.getPriority() != enemyAction.getPriority())
     {
-        std::cout << "You Lose" << std::endl;
+        playerFirst = playerAction.getPriority() > enemyAction.getPriority();
     }
-    else if (enemy.isDefeated())
+    else if (playerAction.getType() == ActionType::ChangeSlime && enemyAction.getType() == ActionType::ChangeSlime)
     {
-        std::cout << "You Win" << std::endl;
+        playerFirst = true;
     }
     else
     {
-        std::cout << "Draw" << std::endl;
+        // on a speed tie the enemy moves first
+        playerFirst = setup.getSpecies(Side::Player, state[Side::Player].active).speed >
+                      setup.getSpecies(Side::Enemy, state[Side::Enemy].active).speed;
+    }
+
+    Side first = playerFirst ? Side::Player : Side::Enemy;
+    Side second = opponentOf(first);
+    const Action &firstAction = playerFirst ? playerAction : enemyAction;
+    const Action &secondAction = playerFirst ? enemyAction : playerAction;
+
+    if (executeAction<Rules>(state, setup, first, firstAction, outcome.hits[sideIndex(first)]))
+    {
+        return true;
+    }
+    return executeAction<Rules>(state, setup, second, secondAction, outcome.hits[sideIndex(second)]);
+}
+
+int Engine::listOutcomes(const BattleState &state, const BattleSetup &setup, const Action &playerAction, const Action &enemyAction,
+                         TurnOutcome *outcomes, double *probabilities)
+{
+    // the outcomes of each side's action on its own, then every combination of both
+    HitOutcome sideOutcomes[2][3];
+    double sideProbabilities[2][3];
+    int sideCounts[2];
+    const Action *actions[2] = {&playerAction, &enemyAction};
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        int s = sideIndex(side);
+        int count = 0;
+        double hit = 1.0;
+        if (actions[s]->getType() == ActionType::UseSkill)
+        {
+            int accuracy = setup.getSpecies(side, state[side].active).skills[actions[s]->getIndex()].accuracy;
+            if (accuracy < 100)
+            {
+                hit = std::max(0, accuracy) / 100.0;
+                sideOutcomes[s][count] = HitOutcome::Miss;
+                sideProbabilities[s][count++] = 1.0 - hit;
+            }
+            if (hit > 0.0 && setup.getCriticalChance() > 0)
+            {
+                double critical = hit * std::min(100, setup.getCriticalChance()) / 100.0;
+                sideOutcomes[s][count] = HitOutcome::Critical;
+                sideProbabilities[s][count++] = critical;
+                hit -= critical;
+            }
+        }
+        if (hit > 0.0)
+        {
+            sideOutcomes[s][count] = HitOutcome::Hit;
+            sideProbabilities[s][count++] = hit;
+        }
+        sideCounts[s] = count;
+    }
+
+    int count = 0;
+    for (int p = 0; p < sideCounts[0]; ++p)
+    {
+        for (int e = 0; e < sideCounts[1]; ++e)
+        {
+            outcomes[count].hits[0] = sideOutcomes[0][p];
+            outcomes[count].hits[1] = sideOutcomes[1][e];
+            probabilities[count++] = sideProbabilities[0][p] * sideProbabilities[1][e];
+        }
+    }
+    return count;
+}
+
+template <typename Rules>
+bool Engine::executeAction(BattleState &state, const BattleSetup &setup, Side attacker, const Action &action, HitOutcome hit)
+{
+    SideState &own = state[attacker];
+    Side defender = opponentOf(attacker);
+    SideState &other = state[defender];
+
+    switch (action.getType())
+    {
+    case ActionType::UseSkill:
+    {
+        if (hit == HitOutcome::Miss)
+        {
+            break;
+        }
+        int damage = setup.getDamage(attacker, own.active, action.getIndex(), other.active, own.boosted);
+        if (hit == HitOutcome::Critical)
+        {
+            damage *= 2;
+        }
+        int16_t &hp = other.hp[other.active];
+        hp = static_cast<int16_t>(std::max(0, hp - damage));
+
+        if (hp == 0)
+        {
+            // remove the attack potion if the slime is killed
+            if constexpr (Rules::kPotions)
+            {
+                other.boosted = false;
+            }
+            return true;
+        }
+        break;
+    }
+    case ActionType::ChangeSlime:
+        // remove attack potion if the slime is changed
+        own.boosted = false;
+        own.active = static_cast<int8_t>(action.getIndex());
+        break;
+    case ActionType::UsePotion:
+        // 0 stands for Revival potion, 1 stands for Attack potion, under rules without potions they do nothing
+        if constexpr (Rules::kPotions)
+        {
+            if (action.getIndex() == 0 && own.revivalPotions > 0)
+            {
+                // like Player::usePotion, the potion is spent even if no slime is beaten
+                own.revivalPotions--;
+                for (int i = 0; i < setup.getTeamSize(attacker); ++i)
+                {
+                    if (own.hp[i] == 0)
+                    {
+                        own.hp[i] = static_cast<int16_t>(setup.getSpecies(attacker, i).maxHP / 2); // heal for half of max HP
+                        break;
+                    }
+                }
+            }
+            else if (action.getIndex() == 1 && own.attackPotions > 0)
+            {
+                own.attackPotions--;
+                own.boosted = true;
+            }
+        }
+        break;
+    }
+    return false;
+}
+
+template <typename Rules>
+int Engine::listActions(const BattleState &state, const BattleSetup &setup, Side side, Action *actions)
+{
+    const SideState &own = state[side];
+    int count = 0;
+    // priorities follow the AI strategies: 0 for skills, 6 for changing slime, 5 for potions
+    for (int i = 0; i < setup.getSpecies(side, own.active).skillCount; ++i)
+    {
+        actions[count++] = Action(ActionType::UseSkill, i, 0);
+    }
+    bool anyBeaten = false;
+    for (int i = 0; i < setup.getTeamSize(side); ++i)
+    {
+        if (own.hp[i] == 0)
+        {
+            anyBeaten = true;
+        }
+        else if (i != own.active)
+        {
+            actions[count++] = Action(ActionType::ChangeSlime, i, 6);
+        }
+    }
+    if constexpr (Rules::kPotions)
+    {
+        if (own.revivalPotions > 0 && anyBeaten)
+        {
+            actions[count++] = Action(ActionType::UsePotion, 0, 5);
+        }
+        if (own.attackPotions > 0 && !own.boosted)
+        {
+            actions[count++] = Action(ActionType::UsePotion, 1, 5);
+        }
+    }
+    return count;
+}
+
+void Engine::sendSlime(BattleState &state, Side side, int index)
+{
+    state[side].active = static_cast<int8_t>(index);
+}
+
+bool Engine::isDefeated(const BattleState &state, Side side)
+{
+    for (int16_t hp : state[side].hp)
+    {
+        if (hp > 0)
+        {
+            return false;
+        }
     }
+    return true;
+}
+
+template <typename Rules>
+bool Engine::isGameOver(const BattleState &state)
+{
+    return isDefeated(state, Side::Player) || isDefeated(state, Side::Enemy) || state.round >= Rules::kRoundLimit;
+}
+
+GameResult Engine::getResult(const BattleState &state)
+{
+    if (isDefeated(state, Side::Player))
+    {
+        return GameResult::Lose;
+    }
+    else if (isDefeated(state, Side::Enemy))
+    {
+        return GameResult::Win;
+    }
+    return GameResult::Draw;
 }
 
 void Engine::setActiveSlimes(Slime *playerSlime, Slime *enemySlime)
 {
     playerActiveSlime = playerSlime;
     enemyActiveSlime = enemySlime;
-}
\ No newline at end of file
+}
+
+// the turn code is compiled once per rule set, each with the branches of the rules it leaves out removed
+template void Engine::resolveTurn<Task1Rules>(const Action &, const Action &);
+template void Engine::resolveTurn<Task2Rules>(const Action &, const Action &);
+template void Engine::resolveTurn<Task3Rules>(const Action &, const Action &);
+template bool Engine::executeTurn<Task1Rules>(BattleState &, const BattleSetup &, const Action &, const Action &, const TurnOutcome &);
+template bool Engine::executeTurn<Task1Rules>(BattleState &, const BattleSetup &, const Action &, const Action &);
+template int Engine::listActions<Task1Rules>(const BattleState &, const BattleSetup &, Side, Action *);
+template bool Engine::isGameOver<Task1Rules>(const BattleState &);
+template bool Engine::executeTurn<Task2Rules>(BattleState &, const BattleSetup &, const Action &, const Action &, const TurnOutcome &);
+template bool Engine::executeTurn<Task2Rules>(BattleState &, const BattleSetup &, const Action &, const Action &);
+template int Engine::listActions<Task2Rules>(const BattleState &, const BattleSetup &, Side, Action *);
+template bool Engine::isGameOver<Task2Rules>(const BattleState &);
+template bool Engine::executeTurn<Task3Rules>(BattleState &, const BattleSetup &, const Action &, const Action &, const TurnOutcome &);
+template bool Engine::executeTurn<Task3Rules>(BattleState &, const BattleSetup &, const Action &, const Action &);
+template int Engine::listActions<Task3Rules>(const BattleState &, const BattleSetup &, Side, Action *);
+template bool Engine::isGameOver<Task3Rules>(const BattleState &);
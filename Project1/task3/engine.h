@@ -1,7 +1,12 @@
 #pragma once
 #include "player.h"
+#include "observer.h"
+#include "battle_state.h"
+#include "rng.h"
 #include <vector>
 
+constexpr int kRoundLimit = Task3Rules::kRoundLimit; /**< The game is a draw once this round is reached, under the task 3 rules */
+
 /**
  * @class Engine
  * @brief Main game engine class that manages the game state and flow.
@@ -14,11 +19,68 @@ class Engine
 public:
     /**
      * @brief Constructs a new Engine with the given players.
+     * @details The battle is printed to std::cout, as in the interactive game.
      * @param player The human player.
      * @param enemy The AI opponent.
      */
     Engine(Player &player, Player &enemy);
 
+    /**
+     * @brief Constructs a new Engine that reports the battle to the given observer.
+     * @param player The human player.
+     * @param enemy The AI opponent.
+     * @param observer The observer receiving the battle events (e.g. a NullObserver for headless games).
+     */
+    Engine(Player &player, Player &enemy, BattleObserver &observer);
+
+    /**
+     * @brief Sets the observer receiving the battle events.
+     * @param observer The new observer.
+     */
+    void setObserver(BattleObserver &observer);
+
+    /**
+     * @brief Sets the random number generator of the battle, shared by the engine and both strategies.
+     * @details Without a call, the engine uses its own generator with seed 0 and stream 0.
+     * @param rng The generator, e.g. Rng(masterSeed, gameIndex), it must outlive the battle.
+     */
+    void setRng(Rng &rng);
+
+    /**
+     * @brief Times every decision of both players with a profiler.
+     * @details The profiler is told when runGame ends, so it can print its histograms after every game.
+     * @param profiler The profiler, it must outlive the battle.
+     */
+    void setProfiler(DecisionProfiler &profiler);
+
+    /**
+     * @brief Turns critical hits on or off, taking effect at the next startGame.
+     * @details A critical hit deals double damage. Skills also miss according to their accuracy,
+     * which needs no switch since every skill of the standard roster has 100 accuracy.
+     * @param percent Chance in percent that a hit is critical, 0 to turn critical hits off.
+     */
+    void setCriticalChance(int percent);
+
+    /**
+     * @brief Plays the next games by another rule set, the task 3 rules by default.
+     * @details Takes effect at the next startGame. The turns are resolved by the turn code compiled
+     * for the rule set, so under rules without potions a potion action does nothing, and the
+     * searching strategies plan with the same rules, see getRules.
+     * @tparam Rules The rule set, see rules.h.
+     */
+    template <typename Rules>
+    void setRules()
+    {
+        rules = Rules::kRuleSet;
+        roundLimit = Rules::kRoundLimit;
+    }
+
+    /**
+     * @brief Gets the rule set the games are played by.
+     * @return The rule set chosen with setRules.
+     */
+    RuleSet getRules() const;
+
     /**
      * @brief Initializes the game, setting up initial slimes and game state.
      */
@@ -29,12 +91,25 @@ public:
      */
     void runGame();
 
+    /**
+     * @brief Puts the battle back to before startGame, so the same objects can play another game.
+     * @details Resets both players (full HP, no boosts, unused potions, no active slime, fresh strategies),
+     * the round counter and the undo journal. The observer, generator, profiler and critical chance are kept.
+     */
+    void reset();
+
     /**
      * @brief Checks if the game has ended.
      * @return true if the game is over, false otherwise.
      */
     bool isGameOver() const;
 
+    /**
+     * @brief Gets the result of a finished game.
+     * @return The result of the game, seen from the human player's side.
+     */
+    GameResult getResult() const;
+
     /**
      * @brief Gets the current round number.
      * @return The current round number.
@@ -53,6 +128,18 @@ public:
      */
     const Player &getEnemy() const;
 
+    /**
+     * @brief Gets the static data of the battle, including its damage table.
+     * @return The setup built by startGame from both players' rosters.
+     */
+    const BattleSetup &getSetup() const;
+
+    /**
+     * @brief Gets the Zobrist hash of the current position.
+     * @return The same value as Zobrist::hash(BattleState::fromEngine(*this)), maintained incrementally.
+     */
+    uint64_t getHash() const;
+
     /**
      * @brief Gets a pointer to the human player's active slime.
      * @return Pointer to the human player's active slime.
@@ -65,12 +152,185 @@ public:
      */
     Slime *getEnemyActiveSlime() const;
 
+    /**
+     * @brief Plays one round with the given actions, recording every change so undoTurn can take it back.
+     * @details The actions are resolved exactly as in a normal round, including a forced replacement
+     * chosen by the beaten slime's strategy, and the round counter advances unless the game is over.
+     * Turns can be nested: each undoTurn takes back the most recent applyTurn.
+     * @param playerAction The action of the human player.
+     * @param enemyAction The action of the AI opponent.
+     */
+    void applyTurn(const Action &playerAction, const Action &enemyAction);
+
+    /**
+     * @brief Puts the battle in the position of a battle state, e.g. to ask the strategies about it.
+     * @details Sets HP, attack boosts, active slimes, unused potions and the round, with the Zobrist
+     * hashes kept up to date, and forgets every turn that could still be undone.
+     * @param state A state of this battle, its starting slimes must have been chosen.
+     */
+    void loadState(const BattleState &state);
+
+    /**
+     * @brief Takes back the most recent turn played with applyTurn.
+     * @details HP, attack boosts, active slimes, potions, the round counter and the Zobrist
+     * hashes are restored exactly. Does nothing if there is no turn to take back.
+     */
+    void undoTurn();
+
+    /**
+     * @brief Executes a turn directly on a battle state, with the same rules as the object-based game.
+     * @details If a slime is beaten the rest of the turn is skipped and the beaten slime stays active
+     * with 0 HP. Unless the game is over, its side must then send a replacement with sendSlime before
+     * the next turn. The round counter is left to the caller, which increments it once the game
+     * is known not to be over.
+     * @tparam Rules The rule set, see rules.h; the setup must have been built for the same rules.
+     * @param state The battle state to update.
+     * @param setup The static data of the battle.
+     * @param playerAction The action chosen by the human player.
+     * @param enemyAction The action chosen by the AI opponent.
+     * @param outcome What becomes of each side's skill, see listOutcomes.
+     * @return true if a slime was beaten during the turn, false otherwise.
+     */
+    template <typename Rules = Task3Rules>
+    static bool executeTurn(BattleState &state, const BattleSetup &setup, const Action &playerAction, const Action &enemyAction,
+                            const TurnOutcome &outcome);
+
+    /**
+     * @brief Executes a turn directly on a battle state, every skill hitting normally.
+     * @details Exact for battles whose skills all have 100 accuracy and without critical hits,
+     * see the overload taking a TurnOutcome for the others.
+     * @tparam Rules The rule set, see rules.h.
+     * @param state The battle state to update.
+     * @param setup The static data of the battle.
+     * @param playerAction The action chosen by the human player.
+     * @param enemyAction The action chosen by the AI opponent.
+     * @return true if a slime was beaten during the turn, false otherwise.
+     */
+    template <typename Rules = Task3Rules>
+    static bool executeTurn(BattleState &state, const BattleSetup &setup, const Action &playerAction, const Action &enemyAction);
+
+    /**
+     * @brief Lists the chance outcomes of a turn with their probabilities.
+     * @details A skill misses with probability 1 - accuracy / 100 and a hit is critical with the
+     * setup's critical chance. Outcomes with probability 0 are left out, so a battle with perfect
+     * accuracy and no critical hits has a single outcome per turn.
+     * @param state The battle state at the start of the turn.
+     * @param setup The static data of the battle.
+     * @param playerAction The action chosen by the human player.
+     * @param enemyAction The action chosen by the AI opponent.
+     * @param outcomes Receives the outcomes, it must have room for kMaxOutcomes entries.
+     * @param probabilities Receives the probability of each outcome, they sum to 1.
+     * @return The number of outcomes written.
+     */
+    static int listOutcomes(const BattleState &state, const BattleSetup &setup, const Action &playerAction, const Action &enemyAction,
+                            TurnOutcome *outcomes, double *probabilities);
+
+    /**
+     * @brief Lists the actions a side may choose on a battle state.
+     * @details Skills come first, then switches to every other slime still standing, then potions.
+     * Potions that would be wasted (a revival potion with no beaten slime, an attack potion on an
+     * already boosted slime) are left out, and so are switches and potions under rules without them.
+     * @tparam Rules The rule set, see rules.h.
+     * @param state The battle state.
+     * @param setup The static data of the battle.
+     * @param side The side choosing an action.
+     * @param actions Receives the actions, it must have room for kMaxActions entries.
+     * @return The number of actions written.
+     */
+    template <typename Rules = Task3Rules>
+    static int listActions(const BattleState &state, const BattleSetup &setup, Side side, Action *actions);
+
+    /**
+     * @brief Sends a slime to the field on a battle state, replacing a beaten active slime.
+     * @param state The battle state to update.
+     * @param side The side sending the slime.
+     * @param index The index of the slime to send.
+     */
+    static void sendSlime(BattleState &state, Side side, int index);
+
+    /**
+     * @brief Checks if a side of a battle state has no slime left.
+     * @param state The battle state.
+     * @param side The side to check.
+     * @return true if every slime of the side is beaten, false otherwise.
+     */
+    static bool isDefeated(const BattleState &state, Side side);
+
+    /**
+     * @brief Checks if the game on a battle state has ended.
+     * @tparam Rules The rule set, see rules.h, giving the round limit.
+     * @param state The battle state.
+     * @return true if the game is over, false otherwise.
+     */
+    template <typename Rules = Task3Rules>
+    static bool isGameOver(const BattleState &state);
+
+    /**
+     * @brief Gets the result of a finished game on a battle state.
+     * @param state The battle state.
+     * @return The result of the game, seen from the human player's side.
+     */
+    static GameResult getResult(const BattleState &state);
+
+    /**
+     * @brief Calculates the damage of an attack from raw stats, under the task 3 rules.
+     * @details The damage is power * attack * effectiveness / defense rounded to the nearest integer,
+     * halves rounded up, and at least 1. It is computed in integer arithmetic only, which gives the
+     * same results as the original float formula for all stats from 1 to 255 (attack up to 510 when
+     * boosted) and skill powers from 1 to 255, see slime_bench --check.
+     * @param power The power of the skill.
+     * @param skillType The type of the skill.
+     * @param attack The attack stat of the attacker (already doubled if boosted).
+     * @param defense The defense stat of the defender.
+     * @param defenderType The type of the defender.
+     * @return The calculated damage.
+     */
+    static int calculateDamage(int power, SkillType skillType, int attack, int defense, SlimeType defenderType);
+
 private:
+    template <typename P, typename E, typename Rules>
+    friend class BattleEngine; // reuses the turn resolution below with its own game loop
+
+    /**
+     * @brief One change recorded by applyTurn, holding the value to restore.
+     */
+    struct JournalEntry
+    {
+        /**
+         * @brief What was changed.
+         */
+        enum class Kind : uint8_t
+        {
+            HP,     /**< A slime's HP, value is the old HP */
+            Boost,  /**< A slime's attack boost, value is the old boost flag */
+            Active, /**< A player's active slime, slime is the old active slime */
+            Potion, /**< A potion was used, value is its Potion::Type */
+            Round   /**< The round counter, value is the old round */
+        };
+
+        Kind kind;     /**< What was changed */
+        Player *owner; /**< The player owning the change, for Active and Potion */
+        Slime *slime;  /**< The slime changed, or the old active slime */
+        int value;     /**< The value to restore */
+    };
+
     Player &player;           /**< Reference to the human player */
     Player &enemy;            /**< Reference to the AI opponent */
+    BattleObserver *observer; /**< Observer receiving the battle events */
     int round;                /**< Current round number */
     Slime *playerActiveSlime; /**< Pointer to the human player's active slime */
     Slime *enemyActiveSlime;  /**< Pointer to the AI opponent's active slime */
+    BattleSetup setup;        /**< Static data and damage table of the battle, built by startGame */
+    int criticalChance = 0;   /**< Chance in percent that a hit is critical */
+    RuleSet rules = RuleSet::Task3; /**< Rule set the games are played by, set by setRules */
+    int roundLimit = kRoundLimit; /**< The game is a draw once this round is reached, set by setRules */
+    Rng ownRng;               /**< Generator used until setRng is called */
+    Rng *rng;                 /**< Generator of every random event of the battle */
+    DecisionProfiler *profiler = nullptr; /**< Profiler timing the players' decisions, or nullptr */
+
+    bool journaling = false;             /**< Whether changes are being recorded, only inside applyTurn */
+    std::vector<JournalEntry> journal;   /**< Changes of all turns that can still be undone, oldest first */
+    std::vector<size_t> turnStarts;      /**< Index of the first journal entry of each turn that can be undone */
 
     /**
      * @brief Updates the game state after each action or round.
@@ -87,31 +347,60 @@ private:
      */
     void executeTurn();
 
+    /**
+     * @brief Executes the actions chosen by both players in priority and speed order.
+     * @tparam Rules The rule set, the one set by setRules.
+     * @param playerAction The action of the human player.
+     * @param enemyAction The action of the AI opponent.
+     */
+    template <typename Rules>
+    void resolveTurn(const Action &playerAction, const Action &enemyAction);
+
+    /**
+     * @brief Executes the actions chosen by both players with the turn code of the engine's rule set.
+     * @param playerAction The action of the human player.
+     * @param enemyAction The action of the AI opponent.
+     */
+    void resolveTurn(const Action &playerAction, const Action &enemyAction);
+
+    /**
+     * @brief Records a change in the journal while a turn is applied with applyTurn.
+     * @param kind What is about to change.
+     * @param owner The player owning the change.
+     * @param slime The slime about to change, or the current active slime.
+     * @param value The value to restore.
+     */
+    void record(JournalEntry::Kind kind, Player *owner, Slime *slime, int value);
+
     /**
      * @brief Executes a single action for a player.
+     * @tparam Rules The rule set, the one set by setRules.
      * @param attacker The player executing the action.
      * @param defender The opposing player.
      * @param action The action to be executed.
      * @return true if the action was successful, false otherwise.
      */
+    template <typename Rules>
     bool executeAction(Player &attacker, Player &defender, const Action &action);
 
     /**
-     * @brief Calculates the damage for an attack.
-     * @param attacker The attacking slime.
-     * @param defender The defending slime.
-     * @param skill The skill being used for the attack.
-     * @return The calculated damage.
+     * @brief Executes a single action for one side of a battle state.
+     * @param state The battle state to update.
+     * @param setup The static data of the battle.
+     * @param attacker The side executing the action.
+     * @param action The action to be executed.
+     * @param hit What becomes of the action if it is a skill.
+     * @return true if the opposing active slime was beaten, false otherwise.
      */
-    int calculateDamage(const Slime &attacker, const Slime &defender, const Skill &skill);
+    template <typename Rules>
+    static bool executeAction(BattleState &state, const BattleSetup &setup, Side attacker, const Action &action, HitOutcome hit);
 
     /**
-     * @brief Determines the effectiveness multiplier based on attack and defender types.
-     * @param attackType The type of the attack.
-     * @param defenderType The type of the defending slime.
-     * @return The effectiveness multiplier.
+     * @brief Gets the side a player is playing on.
+     * @param p One of the two players of this engine.
+     * @return Side::Player for the human player, Side::Enemy for the AI opponent.
      */
-    float getTypeEffectiveness(SkillType attackType, SlimeType defenderType);
+    Side sideOf(const Player &p) const;
 
     /**
      * @brief Displays the current status of the game.
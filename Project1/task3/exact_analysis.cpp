@@ -0,0 +1,110 @@
+#include "exact_analysis.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+// states are compared bytewise, which needs a state without padding bytes of unknown value
+static_assert(sizeof(BattleState) == sizeof(SideState) * 2 + sizeof(int16_t), "BattleState must have no padding");
+
+/**
+ * @brief Hashes a battle state with its Zobrist hash.
+ */
+struct StateHash
+{
+    size_t operator()(const BattleState &state) const { return static_cast<size_t>(Zobrist::hash(state)); }
+};
+
+/**
+ * @brief Compares two battle states byte by byte.
+ */
+struct StateEqual
+{
+    bool operator()(const BattleState &a, const BattleState &b) const { return std::memcmp(&a, &b, sizeof(BattleState)) == 0; }
+};
+
+/**
+ * @brief Probability of every distinct state at the start of a round.
+ */
+using StateDistribution = std::unordered_map<BattleState, double, StateHash, StateEqual>;
+
+ExactAnalyzer::ExactAnalyzer(Engine &engine, Player &player, Player &enemy) : engine(engine), player(player), enemy(enemy) {}
+
+ExactResult ExactAnalyzer::analyze()
+{
+    const BattleSetup &setup = engine.getSetup();
+    ExactResult result;
+    StateDistribution current;
+    current[BattleState::fromEngine(engine)] = 1.0;
+
+    TurnOutcome outcomes[kMaxOutcomes];
+    double probabilities[kMaxOutcomes];
+    while (!current.empty())
+    {
+        result.maxStates = std::max(result.maxStates, current.size());
+        StateDistribution next;
+        next.reserve(current.size() * 2);
+
+        for (const auto &entry : current)
+        {
+            engine.loadState(entry.first);
+            Action playerAction = player.chooseAction(engine);
+            Action enemyAction = enemy.chooseAction(engine);
+
+            int count = Engine::listOutcomes(entry.first, setup, playerAction, enemyAction, outcomes, probabilities);
+            for (int k = 0; k < count; ++k)
+            {
+                double probability = entry.second * probabilities[k];
+                BattleState state = entry.first;
+                Engine::executeTurn(state, setup, playerAction, enemyAction, outcomes[k]);
+                replaceBeaten(state);
+
+                if (!Engine::isGameOver(state))
+                {
+                    state.round++;
+                    next[state] += probability;
+                    continue;
+                }
+                switch (Engine::getResult(state))
+                {
+                case GameResult::Win:
+                    result.win += probability;
+                    break;
+                case GameResult::Lose:
+                    result.lose += probability;
+                    break;
+                case GameResult::Draw:
+                    result.draw += probability;
+                    break;
+                }
+                result.expectedRounds += probability * state.round;
+            }
+        }
+        current.swap(next);
+    }
+    return result;
+}
+
+void ExactAnalyzer::replaceBeaten(BattleState &state)
+{
+    // as in the engine, no replacement is chosen once the game is over
+    if (Engine::isGameOver(state))
+    {
+        return;
+    }
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        const SideState &own = state[side];
+        if (own.hp[own.active] > 0)
+        {
+            continue;
+        }
+        engine.loadState(state);
+        Player &owner = side == Side::Player ? player : enemy;
+        int replacement = owner.chooseNextSlime(engine);
+        if (replacement >= 0)
+        {
+            Engine::sendSlime(state, side, replacement);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include "battle_state.h"
+#include "engine.h"
+#include "player.h"
+
+/**
+ * @brief Exact outcome probabilities of a battle between two strategies.
+ */
+struct ExactResult
+{
+    double win = 0.0;            /**< Probability that the player wins */
+    double lose = 0.0;           /**< Probability that the enemy wins */
+    double draw = 0.0;           /**< Probability that the round limit is reached */
+    double expectedRounds = 0.0; /**< Expected number of rounds played */
+    size_t maxStates = 0;        /**< Most distinct states alive at the start of a round */
+};
+
+/**
+ * @class ExactAnalyzer
+ * @brief Computes the exact result distribution of a battle instead of sampling games.
+ *
+ * The analyzer keeps the probability of every battle state that can be reached at the start of
+ * the current round. Each round it asks both players for their actions in every state, splits
+ * each turn into its chance outcomes (misses and critical hits, see Engine::listOutcomes) and
+ * merges the states that different paths lead to, so the work grows with the number of distinct
+ * states rather than the number of games. Finished games are added to the result as they end.
+ *
+ * The strategies are queried through the engine, which is moved to each state with
+ * Engine::loadState. The result is exact for strategies that decide without random numbers;
+ * a strategy that does draw random numbers is followed along a single sample of its choices.
+ */
+class ExactAnalyzer
+{
+public:
+    /**
+     * @brief Constructs a new ExactAnalyzer.
+     * @param engine The engine running the battle, its starting slimes must have been chosen.
+     * @param player The player of the engine.
+     * @param enemy The enemy of the engine.
+     */
+    ExactAnalyzer(Engine &engine, Player &player, Player &enemy);
+
+    /**
+     * @brief Plays out every possible course of the battle from the engine's current state.
+     * @details Leaves the engine in the last state the strategies were asked about.
+     * @return The exact outcome probabilities.
+     */
+    ExactResult analyze();
+
+private:
+    Engine &engine; /**< The engine used to ask the strategies */
+    Player &player; /**< The player of the engine */
+    Player &enemy;  /**< The enemy of the engine */
+
+    /**
+     * @brief Sends in the replacement of a side whose active slime was beaten during the turn.
+     * @param state The state right after Engine::executeTurn, updated with the replacement.
+     */
+    void replaceBeaten(BattleState &state);
+};
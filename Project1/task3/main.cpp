@@ -2,6 +2,7 @@
 #include "player.h"
 #include "strategy.h"
 #include "slime.h"
+#include "roster.h"
 #include <iostream>
 
 int main()
@@ -9,20 +10,14 @@ int main()
     HumanStrategy *humanStrategy = new HumanStrategy();
     PotionGreedyAIStrategy *enemyStrategy = new PotionGreedyAIStrategy();
 
-    Player human(humanStrategy);
-    Player ai(enemyStrategy);
+    BattleArena arena;
+    Player human(humanStrategy, arena);
+    Player ai(enemyStrategy, arena);
 
-    ai.addPotion(Potion(Potion::Type::Revival));
-    ai.addPotion(Potion(Potion::Type::Attack));
-    ai.addPotion(Potion(Potion::Type::Attack));
+    addStandardPotions(ai);
 
-    human.addSlime(new Slime("Green", SlimeType::Grass, 110, 10, 10, 10));
-    human.addSlime(new Slime("Red", SlimeType::Fire, 100, 11, 10, 11));
-    human.addSlime(new Slime("Blue", SlimeType::Water, 100, 10, 11, 9));
-
-    ai.addSlime(new Slime("Green", SlimeType::Grass, 110, 10, 10, 10));
-    ai.addSlime(new Slime("Red", SlimeType::Fire, 100, 11, 10, 11));
-    ai.addSlime(new Slime("Blue", SlimeType::Water, 100, 10, 11, 9));
+    addStandardSlimes(human);
+    addStandardSlimes(ai);
 
     Engine engine(human, ai);
 
@@ -0,0 +1,160 @@
+#include "matrix_game.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+MatrixGame::MatrixGame(int rows, int cols) : rows(rows), cols(cols), payoffs(), rowStrategy(), colStrategy()
+{
+    if (rows < 1 || cols < 1 || rows > kMaxMatrixSize || cols > kMaxMatrixSize)
+    {
+        throw std::length_error("matrix game larger than kMaxMatrixSize");
+    }
+}
+
+bool MatrixGame::solvePure(double &value)
+{
+    // best row against a column player who sees it (maximin), and best column against a row player who sees it (minimax)
+    int bestRow = 0;
+    double maximin = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < rows; ++i)
+    {
+        double rowMin = *std::min_element(payoffs[i], payoffs[i] + cols);
+        if (rowMin > maximin)
+        {
+            maximin = rowMin;
+            bestRow = i;
+        }
+    }
+
+    int bestCol = 0;
+    double minimax = std::numeric_limits<double>::infinity();
+    for (int j = 0; j < cols; ++j)
+    {
+        double colMax = payoffs[0][j];
+        for (int i = 1; i < rows; ++i)
+        {
+            colMax = std::max(colMax, payoffs[i][j]);
+        }
+        if (colMax < minimax)
+        {
+            minimax = colMax;
+            bestCol = j;
+        }
+    }
+
+    if (maximin < minimax)
+    {
+        return false;
+    }
+    std::fill(rowStrategy, rowStrategy + kMaxMatrixSize, 0.0);
+    std::fill(colStrategy, colStrategy + kMaxMatrixSize, 0.0);
+    rowStrategy[bestRow] = 1.0;
+    colStrategy[bestCol] = 1.0;
+    value = maximin;
+    return true;
+}
+
+double MatrixGame::solve()
+{
+    double value;
+    if (solvePure(value))
+    {
+        return value;
+    }
+
+    // shift every payoff to at least 1, so the game value is positive and the LP below is bounded
+    double lowest = payoffs[0][0];
+    for (int i = 0; i < rows; ++i)
+    {
+        lowest = std::min(lowest, *std::min_element(payoffs[i], payoffs[i] + cols));
+    }
+    double shift = 1.0 - lowest;
+
+    // column player's LP: maximize sum(y) subject to A y <= 1, y >= 0
+    // tableau columns: y (cols), slacks (rows), right hand side
+    const int width = kMaxMatrixSize * 2 + 1;
+    double tableau[kMaxMatrixSize + 1][width] = {};
+    int basis[kMaxMatrixSize];
+    int rhs = cols + rows;
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < cols; ++j)
+        {
+            tableau[i][j] = payoffs[i][j] + shift;
+        }
+        tableau[i][cols + i] = 1.0;
+        tableau[i][rhs] = 1.0;
+        basis[i] = cols + i;
+    }
+    double *objective = tableau[rows];
+    for (int j = 0; j < cols; ++j)
+    {
+        objective[j] = -1.0;
+    }
+
+    const double eps = 1e-12;
+    while (true)
+    {
+        // Bland's rule: lowest entering and leaving indices, which can't cycle
+        int enter = -1;
+        for (int j = 0; j < rhs; ++j)
+        {
+            if (objective[j] < -eps)
+            {
+                enter = j;
+                break;
+            }
+        }
+        if (enter < 0)
+        {
+            break;
+        }
+
+        int leave = -1;
+        double bestRatio = 0.0;
+        for (int i = 0; i < rows; ++i)
+        {
+            if (tableau[i][enter] > eps)
+            {
+                double ratio = tableau[i][rhs] / tableau[i][enter];
+                if (leave < 0 || ratio < bestRatio - eps || (ratio < bestRatio + eps && basis[i] < basis[leave]))
+                {
+                    leave = i;
+                    bestRatio = ratio;
+                }
+            }
+        }
+
+        double pivot = tableau[leave][enter];
+        for (int j = 0; j <= rhs; ++j)
+        {
+            tableau[leave][j] /= pivot;
+        }
+        for (int i = 0; i <= rows; ++i)
+        {
+            if (i != leave && tableau[i][enter] != 0.0)
+            {
+                double factor = tableau[i][enter];
+                for (int j = 0; j <= rhs; ++j)
+                {
+                    tableau[i][j] -= factor * tableau[leave][j];
+                }
+            }
+        }
+        basis[leave] = enter;
+    }
+
+    double total = objective[rhs]; // = sum(y) = 1 / shifted value
+    std::fill(rowStrategy, rowStrategy + kMaxMatrixSize, 0.0);
+    std::fill(colStrategy, colStrategy + kMaxMatrixSize, 0.0);
+    for (int i = 0; i < rows; ++i)
+    {
+        if (basis[i] < cols)
+        {
+            colStrategy[basis[i]] = tableau[i][rhs] / total;
+        }
+        // the row player's strategy is the dual solution, read from the slack columns
+        rowStrategy[i] = objective[cols + i] / total;
+    }
+    return 1.0 / total - shift;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "battle_state.h"
+
+constexpr int kMaxMatrixSize = kMaxActions; /**< Most actions either player of a MatrixGame can have, every turn of any team fits */
+
+/**
+ * @class MatrixGame
+ * @brief A small two-player zero-sum matrix game, solved for its mixed equilibrium.
+ *
+ * The row player maximizes and the column player minimizes the payoff. Games with a
+ * pure saddle point are answered directly, the others by a dense simplex on the
+ * column player's linear program. Everything lives in fixed-size arrays, so solving
+ * never allocates.
+ */
+class MatrixGame
+{
+public:
+    /**
+     * @brief Constructs an empty game of the given size.
+     * @param rows Number of row actions, at most kMaxMatrixSize.
+     * @param cols Number of column actions, at most kMaxMatrixSize.
+     * @throws std::length_error if the game is larger than kMaxMatrixSize in either direction.
+     */
+    MatrixGame(int rows, int cols);
+
+    /**
+     * @brief Sets one payoff of the game.
+     * @param row The row action.
+     * @param col The column action.
+     * @param payoff The payoff of the row player.
+     */
+    void set(int row, int col, double payoff) { payoffs[row][col] = payoff; }
+
+    /**
+     * @brief Gets one payoff of the game.
+     * @param row The row action.
+     * @param col The column action.
+     * @return The payoff of the row player.
+     */
+    double get(int row, int col) const { return payoffs[row][col]; }
+
+    /**
+     * @brief Solves the game.
+     * @return The value of the game for the row player.
+     */
+    double solve();
+
+    /**
+     * @brief Gets the equilibrium probability of a row action, valid after solve().
+     * @param row The row action.
+     * @return The probability the row player plays it.
+     */
+    double getRowStrategy(int row) const { return rowStrategy[row]; }
+
+    /**
+     * @brief Gets the equilibrium probability of a column action, valid after solve().
+     * @param col The column action.
+     * @return The probability the column player plays it.
+     */
+    double getColStrategy(int col) const { return colStrategy[col]; }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+private:
+    int rows;                                 /**< Number of row actions */
+    int cols;                                 /**< Number of column actions */
+    double payoffs[kMaxMatrixSize][kMaxMatrixSize]; /**< Payoffs of the row player */
+    double rowStrategy[kMaxMatrixSize];          /**< Equilibrium strategy of the row player */
+    double colStrategy[kMaxMatrixSize];          /**< Equilibrium strategy of the column player */
+
+    /**
+     * @brief Looks for a pure saddle point and uses it as the solution if there is one.
+     * @param value Receives the value of the game if a saddle point is found.
+     * @return true if the game has a pure saddle point, false otherwise.
+     */
+    bool solvePure(double &value);
+};
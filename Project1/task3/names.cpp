@@ -0,0 +1,49 @@
+#include "names.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Storage of the interned names.
+ * @details A fixed array, so the strings never move and views of them stay valid while names are added.
+ */
+struct NameStorage
+{
+    std::mutex mutex;                        /**< Serializes interning */
+    std::string names[NameTable::kMaxNames]; /**< The names, the first count of them in use */
+    std::atomic<size_t> count{0};            /**< Number of names in use */
+};
+
+// a function-local static is initialized on first use, so static Skill objects can intern their names safely
+static NameStorage &storage()
+{
+    static NameStorage instance;
+    return instance;
+}
+
+NameId NameTable::intern(std::string_view name)
+{
+    NameStorage &table = storage();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    size_t count = table.count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (table.names[i] == name)
+        {
+            return static_cast<NameId>(i);
+        }
+    }
+    if (count == kMaxNames)
+    {
+        throw std::length_error("too many distinct names");
+    }
+    table.names[count] = std::string(name);
+    table.count.store(count + 1, std::memory_order_release);
+    return static_cast<NameId>(count);
+}
+
+std::string_view NameTable::get(NameId id)
+{
+    return storage().names[id];
+}
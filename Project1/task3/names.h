@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using NameId = uint16_t; /**< Index of a name in the NameTable */
+
+/**
+ * @class NameTable
+ * @brief The process-wide table of interned slime and skill names.
+ *
+ * Every distinct name is stored once, so slimes and skills carry a small NameId instead of
+ * their own string, and getting a name back is an array lookup that never allocates.
+ * Interning is thread-safe; names are never removed, and the views returned by get stay
+ * valid until the program ends.
+ */
+class NameTable
+{
+public:
+    static constexpr size_t kMaxNames = 256; /**< Most distinct names the table can hold */
+
+    /**
+     * @brief Gets the id of a name, adding the name on first use.
+     * @param name The name.
+     * @return The id of the name, the same for every equal name.
+     * @throws std::length_error if the table already holds kMaxNames other names.
+     */
+    static NameId intern(std::string_view name);
+
+    /**
+     * @brief Gets an interned name.
+     * @param id An id returned by intern.
+     * @return The name.
+     */
+    static std::string_view get(NameId id);
+};
@@ -0,0 +1,101 @@
+#include "observer.h"
+#include "slime.h"
+
+TextObserver::TextObserver(std::ostream &out) : out(out) {}
+
+void TextObserver::onGameStart()
+{
+    out << "Welcome to Battle of Slimes!\n";
+    out << "You have Green, Red and Blue. So does Enemy.\n";
+}
+
+void TextObserver::onStartingSlimes(const Slime &playerSlime, const Slime &enemySlime)
+{
+    out << "You start with " << playerSlime.getName() << "\n";
+    out << "Enemy starts with " << enemySlime.getName() << "\n";
+}
+
+void TextObserver::onBattleStart()
+{
+    out << "Battle starts!\n";
+}
+
+void TextObserver::onStatus(const Slime &playerSlime, const Slime &enemySlime)
+{
+    out << "Your " << playerSlime.getName() << ": HP " << playerSlime.getCurrentHP() << " || Enemy's " << enemySlime.getName() << ": HP " << enemySlime.getCurrentHP() << "\n";
+}
+
+void TextObserver::onRoundStart(int round)
+{
+    out << "------------------------------------\n";
+    out << "Round " << round << "\n";
+}
+
+void TextObserver::onSkillUsed(Side side, const Slime &attacker, const Skill &skill, int damage)
+{
+    out << (side == Side::Player ? "Your " : "Enemy's ");
+    out << attacker.getName() << " uses " << skill.getName() << "! Damage: " << damage << "\n";
+}
+
+void TextObserver::onSkillMissed(Side side, const Slime &attacker, const Skill &skill)
+{
+    out << (side == Side::Player ? "Your " : "Enemy's ");
+    out << attacker.getName() << " uses " << skill.getName() << "! It missed!\n";
+}
+
+void TextObserver::onCriticalHit(Side, const Slime &)
+{
+    out << "It's a critical hit!\n";
+}
+
+void TextObserver::onSlimeBeaten(Side side, const Slime &slime)
+{
+    out << (side == Side::Player ? "Your " : "Enemy's ");
+    out << slime.getName() << " is beaten\n";
+}
+
+void TextObserver::onBoostRemoved(Side, const Slime &slime)
+{
+    out << slime.getName() << " is no longer boosted!\n";
+}
+
+void TextObserver::onSlimeSent(Side side, const Slime &slime)
+{
+    out << (side == Side::Player ? "You send " : "Enemy sends ");
+    out << slime.getName() << "\n";
+}
+
+void TextObserver::onPotionUsed(Side side, Potion::Type type, const Slime *target)
+{
+    out << (side == Side::Player ? "You use " : "Enemy uses ");
+    if (type == Potion::Type::Revival)
+    {
+        out << "Revival Potion\n";
+    }
+    else
+    {
+        out << "Attack Potion on " << target->getName() << "\n";
+    }
+}
+
+void TextObserver::onNothingToRevive(Side)
+{
+    out << "No defeated slime to revive!\n";
+}
+
+void TextObserver::onGameEnd(GameResult result)
+{
+    switch (result)
+    {
+    case GameResult::Lose:
+        out << "You Lose\n";
+        break;
+    case GameResult::Win:
+        out << "You Win\n";
+        break;
+    case GameResult::Draw:
+        out << "Draw\n";
+        break;
+    }
+    out.flush();
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <iostream>
+#include "side.h"
+#include "potion.h"
+
+class Slime;
+class Skill;
+
+/**
+ * @brief Enumeration of possible game results, seen from the player's side.
+ */
+enum class GameResult
+{
+    Win,  /**< All of the enemy's slimes are beaten */
+    Lose, /**< All of the player's slimes are beaten */
+    Draw  /**< The round limit is reached */
+};
+
+/**
+ * @class BattleObserver
+ * @brief Interface for receiving the events raised by the Engine during a battle.
+ *
+ * The Engine never writes to the terminal itself. Everything it used to print is
+ * reported through this interface, so the same game loop can drive the interactive
+ * game (TextObserver) or run headless (NullObserver).
+ */
+class BattleObserver
+{
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes.
+     */
+    virtual ~BattleObserver() = default;
+
+    /**
+     * @brief Called before the starting slimes are chosen.
+     */
+    virtual void onGameStart() = 0;
+
+    /**
+     * @brief Called once both starting slimes have been chosen.
+     * @param playerSlime The player's starting slime.
+     * @param enemySlime The enemy's starting slime.
+     */
+    virtual void onStartingSlimes(const Slime &playerSlime, const Slime &enemySlime) = 0;
+
+    /**
+     * @brief Called after the initial status is shown, right before the first round.
+     */
+    virtual void onBattleStart() = 0;
+
+    /**
+     * @brief Called whenever the active slimes' status should be reported.
+     * @param playerSlime The player's active slime.
+     * @param enemySlime The enemy's active slime.
+     */
+    virtual void onStatus(const Slime &playerSlime, const Slime &enemySlime) = 0;
+
+    /**
+     * @brief Called at the beginning of every round.
+     * @param round The round number.
+     */
+    virtual void onRoundStart(int round) = 0;
+
+    /**
+     * @brief Called after a skill has hit.
+     * @param side The side whose slime used the skill.
+     * @param attacker The slime that used the skill.
+     * @param skill The skill that was used.
+     * @param damage The damage dealt.
+     */
+    virtual void onSkillUsed(Side side, const Slime &attacker, const Skill &skill, int damage) = 0;
+
+    /**
+     * @brief Called when a skill misses.
+     * @param side The side whose slime used the skill.
+     * @param attacker The slime that used the skill.
+     * @param skill The skill that missed.
+     */
+    virtual void onSkillMissed(Side side, const Slime &attacker, const Skill &skill) = 0;
+
+    /**
+     * @brief Called after onSkillUsed when the hit was critical.
+     * @param side The side whose slime landed the critical hit.
+     * @param attacker The slime that landed the critical hit.
+     */
+    virtual void onCriticalHit(Side side, const Slime &attacker) = 0;
+
+    /**
+     * @brief Called when a slime's HP drops to zero.
+     * @param side The side owning the beaten slime.
+     * @param slime The beaten slime.
+     */
+    virtual void onSlimeBeaten(Side side, const Slime &slime) = 0;
+
+    /**
+     * @brief Called when a slime loses its attack boost by being switched out.
+     * @param side The side owning the slime.
+     * @param slime The slime that is no longer boosted.
+     */
+    virtual void onBoostRemoved(Side side, const Slime &slime) = 0;
+
+    /**
+     * @brief Called when a side sends a new slime to the field.
+     * @param side The side sending the slime.
+     * @param slime The slime that was sent.
+     */
+    virtual void onSlimeSent(Side side, const Slime &slime) = 0;
+
+    /**
+     * @brief Called when a potion is used.
+     * @param side The side using the potion.
+     * @param type The type of the potion.
+     * @param target The slime the potion is used on (nullptr for revival potions).
+     */
+    virtual void onPotionUsed(Side side, Potion::Type type, const Slime *target) = 0;
+
+    /**
+     * @brief Called after onPotionUsed when a revival potion found no beaten slime to revive.
+     * @param side The side that used the potion.
+     */
+    virtual void onNothingToRevive(Side side) = 0;
+
+    /**
+     * @brief Called once the game is over.
+     * @param result The result of the game, seen from the player's side.
+     */
+    virtual void onGameEnd(GameResult result) = 0;
+};
+
+/**
+ * @class TextObserver
+ * @brief Observer that prints the battle to a text stream, as the interactive game does.
+ */
+class TextObserver : public BattleObserver
+{
+public:
+    /**
+     * @brief Constructs a new TextObserver.
+     * @param out The stream the battle is printed to.
+     */
+    explicit TextObserver(std::ostream &out = std::cout);
+
+    void onGameStart() override;
+    void onStartingSlimes(const Slime &playerSlime, const Slime &enemySlime) override;
+    void onBattleStart() override;
+    void onStatus(const Slime &playerSlime, const Slime &enemySlime) override;
+    void onRoundStart(int round) override;
+    void onSkillUsed(Side side, const Slime &attacker, const Skill &skill, int damage) override;
+    void onSkillMissed(Side side, const Slime &attacker, const Skill &skill) override;
+    void onCriticalHit(Side side, const Slime &attacker) override;
+    void onSlimeBeaten(Side side, const Slime &slime) override;
+    void onBoostRemoved(Side side, const Slime &slime) override;
+    void onSlimeSent(Side side, const Slime &slime) override;
+    void onPotionUsed(Side side, Potion::Type type, const Slime *target) override;
+    void onNothingToRevive(Side side) override;
+    void onGameEnd(GameResult result) override;
+
+private:
+    std::ostream &out; /**< The stream the battle is printed to */
+};
+
+/**
+ * @class NullObserver
+ * @brief Observer that ignores every event, used for headless simulation.
+ */
+class NullObserver final : public BattleObserver
+{
+public:
+    void onGameStart() override {}
+    void onStartingSlimes(const Slime &, const Slime &) override {}
+    void onBattleStart() override {}
+    void onStatus(const Slime &, const Slime &) override {}
+    void onRoundStart(int) override {}
+    void onSkillUsed(Side, const Slime &, const Skill &, int) override {}
+    void onSkillMissed(Side, const Slime &, const Skill &) override {}
+    void onCriticalHit(Side, const Slime &) override {}
+    void onSlimeBeaten(Side, const Slime &) override {}
+    void onBoostRemoved(Side, const Slime &) override {}
+    void onSlimeSent(Side, const Slime &) override {}
+    void onPotionUsed(Side, Potion::Type, const Slime *) override {}
+    void onNothingToRevive(Side) override {}
+    void onGameEnd(GameResult) override {}
+};
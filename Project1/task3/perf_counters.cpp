@@ -0,0 +1,202 @@
+#include "perf_counters.h"
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+void PerfReading::add(const PerfReading &other)
+{
+    for (int i = 0; i < static_cast<int>(PerfEvent::Count); ++i)
+    {
+        values[i] += other.values[i];
+        available[i] = available[i] || other.available[i];
+    }
+}
+
+void PerfReading::print(std::ostream &out, long long units, const char *unitName) const
+{
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    bool any = false;
+    for (int i = 0; i < static_cast<int>(PerfEvent::Count); ++i)
+    {
+        if (available[i])
+        {
+            any = true;
+            out << PerfCounters::getName(static_cast<PerfEvent>(i)) << " per " << unitName << ": "
+                << (units > 0 ? static_cast<double>(values[i]) / units : 0.0) << "\n";
+        }
+    }
+    int cycles = static_cast<int>(PerfEvent::Cycles);
+    int instructions = static_cast<int>(PerfEvent::Instructions);
+    if (available[cycles] && available[instructions] && values[cycles] > 0)
+    {
+        out << std::setprecision(2) << "instructions per cycle: " << static_cast<double>(values[instructions]) / values[cycles] << "\n";
+    }
+    if (!any)
+    {
+        out << "No performance counters available (no PMU, or kernel.perf_event_paranoid too strict)\n";
+    }
+    else
+    {
+        const char *separator = "Not available here: ";
+        for (int i = 0; i < static_cast<int>(PerfEvent::Count); ++i)
+        {
+            if (!available[i])
+            {
+                out << separator << PerfCounters::getName(static_cast<PerfEvent>(i));
+                separator = ", ";
+            }
+        }
+        if (separator[0] == ',')
+        {
+            out << "\n";
+        }
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+const char *PerfCounters::getName(PerfEvent event)
+{
+    switch (event)
+    {
+    case PerfEvent::TaskClock:
+        return "task-clock-ns";
+    case PerfEvent::Cycles:
+        return "cycles";
+    case PerfEvent::Instructions:
+        return "instructions";
+    case PerfEvent::BranchMisses:
+        return "branch-misses";
+    case PerfEvent::L1DMisses:
+        return "L1-dcache-load-misses";
+    case PerfEvent::LLCMisses:
+        return "LLC-load-misses";
+    default:
+        return "unknown";
+    }
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Opens one counter of the calling thread, disabled, in the given group.
+ * @return The file descriptor, or -1 if the counter is not available.
+ */
+static int openCounter(uint32_t type, uint64_t config, int groupFd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0; // the leader starts and stops the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+PerfCounters::PerfCounters()
+{
+    const uint64_t cacheReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const struct
+    {
+        uint32_t type;
+        uint64_t config;
+    } events[] = {{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+                  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                  {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cacheReadMiss},
+                  {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cacheReadMiss}};
+    for (int i = 0; i < static_cast<int>(PerfEvent::Count); ++i)
+    {
+        // the first counter that opens leads the group, a counter that fails is left out
+        fds[i] = openCounter(events[i].type, events[i].config, leader);
+        slots[i] = fds[i] >= 0 ? opened++ : -1;
+        if (fds[i] >= 0 && leader < 0)
+        {
+            leader = fds[i];
+        }
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+void PerfCounters::start()
+{
+    if (leader >= 0)
+    {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+void PerfCounters::stop()
+{
+    if (leader >= 0)
+    {
+        ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+PerfReading PerfCounters::read() const
+{
+    PerfReading reading;
+    if (leader < 0)
+    {
+        return reading;
+    }
+    // group layout: number of counters, time enabled, time running, then one value per counter
+    uint64_t buffer[3 + static_cast<int>(PerfEvent::Count)];
+    ssize_t size = ::read(leader, buffer, sizeof(buffer));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) || buffer[0] != static_cast<uint64_t>(opened))
+    {
+        return reading;
+    }
+    double scale = buffer[2] > 0 ? static_cast<double>(buffer[1]) / buffer[2] : 0.0;
+    for (int i = 0; i < static_cast<int>(PerfEvent::Count); ++i)
+    {
+        if (slots[i] >= 0)
+        {
+            reading.available[i] = true;
+            reading.values[i] = static_cast<uint64_t>(buffer[3 + slots[i]] * scale);
+        }
+    }
+    return reading;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+{
+    for (int i = 0; i < static_cast<int>(PerfEvent::Count); ++i)
+    {
+        fds[i] = -1;
+        slots[i] = -1;
+    }
+}
+
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+void PerfCounters::stop() {}
+PerfReading PerfCounters::read() const { return PerfReading(); }
+
+#endif
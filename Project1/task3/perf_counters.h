@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @enum PerfEvent
+ * @brief The events counted by PerfCounters.
+ */
+enum class PerfEvent
+{
+    TaskClock,    ///< Time the thread ran on a CPU, in nanoseconds, a software counter
+    Cycles,       ///< CPU cycles
+    Instructions, ///< Instructions retired
+    BranchMisses, ///< Mispredicted branches
+    L1DMisses,    ///< Level 1 data cache read misses
+    LLCMisses,    ///< Last level cache read misses
+    Count         ///< Number of events
+};
+
+/**
+ * @brief Counter values read from PerfCounters, or summed over several of them.
+ */
+struct PerfReading
+{
+    uint64_t values[static_cast<int>(PerfEvent::Count)] = {};  /**< Value of every counter, 0 if unavailable */
+    bool available[static_cast<int>(PerfEvent::Count)] = {}; /**< Whether each counter could be opened */
+
+    /**
+     * @brief Adds another reading, a counter stays available if it is in either.
+     * @param other The reading to add.
+     */
+    void add(const PerfReading &other);
+
+    /**
+     * @brief Prints every available counter divided by a number of units, e.g. per game, and the instructions per cycle.
+     * @param out The stream to print to.
+     * @param units The number to divide by.
+     * @param unitName What a unit is, e.g. "game".
+     */
+    void print(std::ostream &out, long long units, const char *unitName) const;
+};
+
+/**
+ * @class PerfCounters
+ * @brief A group of Linux hardware performance counters for the calling thread, read with perf_event_open.
+ *
+ * The counters are opened as one group so they are scheduled together, and read values are
+ * scaled up when the kernel had to multiplex the group. Counters the kernel or the CPU does
+ * not offer (no PMU in a virtual machine, perf_event_paranoid too strict, another OS) are
+ * simply left out: the group then counts whatever it could open, possibly nothing.
+ * Only the thread that created the counters is counted.
+ */
+class PerfCounters
+{
+public:
+    /**
+     * @brief Opens the counters for the calling thread, stopped.
+     */
+    PerfCounters();
+
+    /**
+     * @brief Closes the counters.
+     */
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /**
+     * @brief Checks if any counter could be opened.
+     * @return true if at least one counter counts, false otherwise.
+     */
+    bool isAvailable() const { return leader >= 0; }
+
+    /**
+     * @brief Resets the counters to zero and starts counting.
+     */
+    void start();
+
+    /**
+     * @brief Stops counting, the counts are kept until the next start.
+     */
+    void stop();
+
+    /**
+     * @brief Reads the counters.
+     * @return The counts since the last start, scaled for multiplexing.
+     */
+    PerfReading read() const;
+
+    /**
+     * @brief Gets the display name of an event.
+     * @param event The event.
+     * @return The name, e.g. "branch-misses".
+     */
+    static const char *getName(PerfEvent event);
+
+private:
+    int fds[static_cast<int>(PerfEvent::Count)];   /**< File descriptor of every counter, -1 if it could not be opened */
+    int slots[static_cast<int>(PerfEvent::Count)]; /**< Position of every counter in the group read, -1 if unavailable */
+    int leader = -1;                               /**< File descriptor of the group leader, -1 if no counter is open */
+    int opened = 0;                                /**< Number of counters in the group */
+};
@@ -1,68 +1,188 @@
 #include "player.h"
 #include "engine.h"
-#include <iostream>
+#include "zobrist.h"
+#include "profiler.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <stdexcept>
 
-Player::Player(Strategy *strategy) : strategy(strategy), activeSlime(nullptr) {}
+Player::Player(Strategy *strategy, BattleArena &arena)
+    : strategy(strategy), arena(arena), slimes(arena.allocate<Slime>(kMaxTeamSize)), activeSlime(nullptr) {}
 
 Player::~Player()
 {
-    for (auto slime : slimes)
+    delete strategy;
+}
+
+void Player::addSlime(const Slime &slime)
+{
+    if (slimeCount == kMaxTeamSize)
     {
-        delete slime;
+        throw std::length_error("team is larger than kMaxTeamSize");
     }
-    delete strategy;
+    if (slime.getMaxHP() < 0 || slime.getMaxHP() > kZobristMaxHP)
+    {
+        throw std::out_of_range("slime HP is above kZobristMaxHP");
+    }
+    if (!slimes)
+    {
+        slimes = arena.allocate<Slime>(kMaxTeamSize);
+    }
+    Slime *added = new (&slimes[slimeCount]) Slime(slime);
+    added->attachHash(&hash, side, slimeCount);
+    slimeCount++;
+    rehash();
 }
 
-void Player::addSlime(Slime *slime)
+void Player::clearSlimes()
 {
-    slimes.push_back(slime);
+    slimes = nullptr;
+    slimeCount = 0;
+    activeSlime = nullptr;
+    rehash();
 }
 
 void Player::setActiveSlime(Slime *slime)
 {
+    if (activeSlime)
+    {
+        hash ^= Zobrist::active(side, activeSlime->getSlot());
+    }
     activeSlime = slime;
+    if (activeSlime)
+    {
+        hash ^= Zobrist::active(side, activeSlime->getSlot());
+    }
 }
 
-Action Player::chooseAction(const Engine &engine)
+void Player::setSide(Side side)
 {
-    return strategy->chooseAction(engine);
+    this->side = side;
+    if (strategy)
+    {
+        strategy->setSide(side);
+    }
+    for (int i = 0; i < slimeCount; ++i)
+    {
+        slimes[i].attachHash(&hash, side, i);
+    }
+    rehash();
 }
 
-Slime *Player::chooseStartingSlime(const Engine &engine)
+void Player::setRng(Rng &rng)
 {
-    return strategy->chooseStartingSlime(slimes, engine);
+    if (strategy)
+    {
+        strategy->setRng(rng);
+    }
 }
 
-Slime *Player::chooseNextSlime(const Engine &engine)
+void Player::rehash()
 {
-    return strategy->chooseNextSlime(slimes, engine);
+    hash = 0;
+    // by count rather than getSlimes, the team may still be incomplete
+    for (int i = 0; i < slimeCount; ++i)
+    {
+        hash ^= Zobrist::hp(side, i, slimes[i].getCurrentHP());
+        if (slimes[i].isAttackBoosted())
+        {
+            hash ^= Zobrist::boosted(side, i);
+        }
+    }
+    // slots beyond the roster count as beaten slimes, as in a zero-filled BattleState
+    for (int i = slimeCount; i < kMaxTeamSize; ++i)
+    {
+        hash ^= Zobrist::hp(side, i, 0);
+    }
+    if (activeSlime)
+    {
+        hash ^= Zobrist::active(side, activeSlime->getSlot());
+    }
+    hash ^= Zobrist::revivalPotions(side, countPotions(Potion::Type::Revival));
+    hash ^= Zobrist::attackPotions(side, countPotions(Potion::Type::Attack));
 }
 
-Slime *Player::getActiveSlime() const
+int Player::countPotions(Potion::Type type) const
 {
-    return activeSlime;
+    return static_cast<int>(std::count_if(potions.begin(), potions.end(), [type](const Potion &p)
+                                          { return p.getType() == type && !p.isUsed(); }));
+}
+
+void Player::setProfiler(DecisionProfiler *profiler) { this->profiler = profiler; }
+
+/**
+ * @brief Gets the time elapsed since a point in time.
+ * @param start The point in time.
+ * @return The elapsed time in nanoseconds.
+ */
+static uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
 }
 
-const std::vector<Slime *> &Player::getSlimes() const
+Action Player::chooseAction(const Engine &engine)
 {
-    return slimes;
+    TRACE_SPAN("Strategy::chooseAction", strategy->getName());
+    if (!profiler)
+    {
+        return strategy->chooseAction(engine);
+    }
+    auto start = std::chrono::steady_clock::now();
+    Action action = strategy->chooseAction(engine);
+    profiler->record(strategy->getName(), Decision::Action, nanosecondsSince(start));
+    return action;
 }
 
-bool Player::isDefeated() const
+int Player::chooseStartingSlime(const Engine &engine)
 {
-    for (const auto &slime : slimes)
+    TRACE_SPAN("Strategy::chooseStartingSlime", strategy->getName());
+    if (!profiler)
     {
-        if (!slime->isDefeated())
-        {
-            return false;
-        }
+        return strategy->chooseStartingSlime(getSlimes(), engine);
+    }
+    auto start = std::chrono::steady_clock::now();
+    int index = strategy->chooseStartingSlime(getSlimes(), engine);
+    profiler->record(strategy->getName(), Decision::StartingSlime, nanosecondsSince(start));
+    return index;
+}
+
+int Player::chooseNextSlime(const Engine &engine)
+{
+    TRACE_SPAN("Strategy::chooseNextSlime", strategy->getName());
+    if (!profiler)
+    {
+        return strategy->chooseNextSlime(getSlimes(), engine);
     }
-    return true;
+    auto start = std::chrono::steady_clock::now();
+    int index = strategy->chooseNextSlime(getSlimes(), engine);
+    profiler->record(strategy->getName(), Decision::NextSlime, nanosecondsSince(start));
+    return index;
+}
+
+Slime *Player::getActiveSlime() const
+{
+    return activeSlime;
+}
+
+bool Player::isDefeated() const
+{
+    SlimeList team = getSlimes();
+    return findSlot(team, [&](int i)
+                    { return !team[i].isDefeated(); }) < 0;
 }
 
 void Player::addPotion(const Potion &potion)
 {
+    // used potions count too, they are unused again once the player is reset
+    if (std::count_if(potions.begin(), potions.end(), [&potion](const Potion &p)
+                      { return p.getType() == potion.getType(); }) == kZobristMaxPotions)
+    {
+        throw std::length_error("more potions of a type than kZobristMaxPotions");
+    }
     potions.push_back(potion);
+    rehash();
 }
 
 const std::vector<Potion> &Player::getPotions() const
@@ -77,7 +197,10 @@ bool Player::usePotion(Potion::Type type, Slime *target)
                            { return p.getType() == type && !p.isUsed(); });
     if (it != potions.end())
     {
+        int unused = countPotions(type);
         it->use(); // set the potion to used
+        hash ^= type == Potion::Type::Revival ? Zobrist::revivalPotions(side, unused) ^ Zobrist::revivalPotions(side, unused - 1)
+                                              : Zobrist::attackPotions(side, unused) ^ Zobrist::attackPotions(side, unused - 1);
         if (type == Potion::Type::Attack && target)
         {
             target->boostAttack();
@@ -85,18 +208,18 @@ bool Player::usePotion(Potion::Type type, Slime *target)
         else if (type == Potion::Type::Revival)
         {
             // Find the first defeated slime and revive it
-            auto defeatedSlime = std::find_if(slimes.begin(), slimes.end(),
-                                              [](const Slime *s)
-                                              { return s->isDefeated(); });
-            if (defeatedSlime != slimes.end())
+            SlimeList team = getSlimes();
+            auto defeatedSlime = std::find_if(team.begin(), team.end(),
+                                              [](const Slime &s)
+                                              { return s.isDefeated(); });
+            if (defeatedSlime != team.end())
             {
-                int healAmount = (*defeatedSlime)->getMaxHP() / 2; // Heal for half of max HP
-                (*defeatedSlime)->heal(healAmount);
+                int healAmount = defeatedSlime->getMaxHP() / 2; // Heal for half of max HP
+                defeatedSlime->heal(healAmount);
             }
             else
             {
-                std::cout << "No defeated slime to revive!" << std::endl;
-                return false; // Potion wasn't actually used
+                return false; // the potion is spent, but no slime was revived; the engine reports it
             }
         }
         return true;
@@ -104,6 +227,61 @@ bool Player::usePotion(Potion::Type type, Slime *target)
     return false;
 }
 
+void Player::restorePotion(Potion::Type type)
+{
+    auto it = std::find_if(potions.rbegin(), potions.rend(),
+                           [type](const Potion &p)
+                           { return p.getType() == type && p.isUsed(); });
+    if (it != potions.rend())
+    {
+        int unused = countPotions(type);
+        it->reset();
+        hash ^= type == Potion::Type::Revival ? Zobrist::revivalPotions(side, unused) ^ Zobrist::revivalPotions(side, unused + 1)
+                                              : Zobrist::attackPotions(side, unused) ^ Zobrist::attackPotions(side, unused + 1);
+    }
+}
+
+void Player::setUnusedPotions(Potion::Type type, int count)
+{
+    // potions are used front to back, so the unused ones are the last ones of their type
+    for (auto it = potions.rbegin(); it != potions.rend(); ++it)
+    {
+        if (it->getType() != type)
+        {
+            continue;
+        }
+        if (count > 0)
+        {
+            it->reset();
+            count--;
+        }
+        else
+        {
+            it->use();
+        }
+    }
+    rehash();
+}
+
+void Player::reset()
+{
+    for (Slime &slime : getSlimes())
+    {
+        slime.restoreHP(slime.getMaxHP());
+        slime.resetAttackBoost();
+    }
+    for (const Potion &potion : potions)
+    {
+        potion.reset();
+    }
+    activeSlime = nullptr;
+    if (strategy)
+    {
+        strategy->reset();
+    }
+    rehash();
+}
+
 bool Player::canUseRevivalPotion() const
 {
     return (std::any_of(potions.begin(), potions.end(), [](const Potion &p)
@@ -1,10 +1,13 @@
 #pragma once
 #include <vector>
+#include "arena.h"
 #include "slime.h"
 #include "strategy.h"
 #include "potion.h"
 
 class Engine;
+class Rng;
+class DecisionProfiler;
 
 /**
  * @class Player
@@ -19,20 +22,31 @@ public:
     /**
      * @brief Constructs a new Player with the given strategy.
      * @param strategy Pointer to the Strategy object that will guide the player's decisions.
+     * @param arena The arena of the battle, holding the player's slimes; it must outlive the player.
+     * @throws std::length_error if the arena has no room left for a team of kMaxTeamSize slimes.
      */
-    Player(Strategy *strategy);
+    Player(Strategy *strategy, BattleArena &arena);
 
     /**
      * @brief Destructor for the Player class.
-     * Responsible for cleaning up dynamically allocated resources.
+     * Responsible for cleaning up dynamically allocated resources, the slimes go with the arena.
      */
     ~Player();
 
     /**
-     * @brief Adds a slime to the player's collection.
-     * @param slime Pointer to the Slime object to be added.
+     * @brief Adds a copy of a slime to the player's team.
+     * @param slime The slime to be added.
+     * @throws std::length_error if the team already has kMaxTeamSize slimes.
+     * @throws std::out_of_range if the slime's max HP is above kZobristMaxHP, the highest HP with a Zobrist key.
      */
-    void addSlime(Slime *slime);
+    void addSlime(const Slime &slime);
+
+    /**
+     * @brief Drops the player's team, so the battle's arena can be reset and a new team added.
+     * @details The slimes are not destroyed, their storage goes back with the next arena reset. The next
+     * addSlime takes room for a new team from the arena. The player has no team until then, and getSlimes is empty.
+     */
+    void clearSlimes();
 
     /**
      * @brief Sets the active slime for the player.
@@ -40,6 +54,30 @@ public:
      */
     void setActiveSlime(Slime *slime);
 
+    /**
+     * @brief Tells the player's strategy which side it is playing for.
+     * @param side The side this player is playing on.
+     */
+    void setSide(Side side);
+
+    /**
+     * @brief Sets the random number generator of the player's strategy.
+     * @param rng The generator, it must outlive the strategy's use of it.
+     */
+    void setRng(Rng &rng);
+
+    /**
+     * @brief Gets the strategy guiding the player's decisions.
+     * @return Pointer to the strategy, owned by the player.
+     */
+    Strategy *getStrategy() const { return strategy; }
+
+    /**
+     * @brief Times every decision of the player's strategy with a profiler.
+     * @param profiler The profiler, nullptr to stop timing.
+     */
+    void setProfiler(DecisionProfiler *profiler);
+
     /**
      * @brief Chooses an action for the player based on the current game state.
      * @param engine Reference to the Engine object representing the current game state.
@@ -50,16 +88,16 @@ public:
     /**
      * @brief Chooses the starting slime for the player at the beginning of the game.
      * @param engine Reference to the Engine object representing the current game state.
-     * @return Pointer to the chosen starting Slime object.
+     * @return Index of the chosen starting slime in getSlimes().
      */
-    Slime *chooseStartingSlime(const Engine &engine);
+    int chooseStartingSlime(const Engine &engine);
 
     /**
      * @brief Chooses the next slime for the player when switching is necessary.
      * @param engine Reference to the Engine object representing the current game state.
-     * @return Pointer to the chosen next Slime object.
+     * @return Index of the chosen next slime in getSlimes(), or -1 for none.
      */
-    Slime *chooseNextSlime(const Engine &engine);
+    int chooseNextSlime(const Engine &engine);
 
     /**
      * @brief Gets the player's currently active slime.
@@ -68,10 +106,17 @@ public:
     Slime *getActiveSlime() const;
 
     /**
-     * @brief Gets a const reference to the vector of all the player's slimes.
-     * @return Const reference to the vector of Slime pointers.
+     * @brief Gets all the player's slimes.
+     * @details With a fixed team size, the view is empty until the team is complete, e.g. after clearSlimes.
+     * @return A view of the slimes, in the order they were added.
      */
-    const std::vector<Slime *> &getSlimes() const;
+    SlimeList getSlimes() const { return SlimeList(slimes, static_cast<size_t>(slimeCount)); }
+
+    /**
+     * @brief Gets the number of slimes added so far.
+     * @return The number of slimes in the team.
+     */
+    int getTeamSize() const { return slimeCount; }
 
     /**
      * @brief Checks if the player is defeated (all slimes are defeated).
@@ -82,6 +127,8 @@ public:
     /**
      * @brief Adds a potion to the player's inventory.
      * @param potion The potion to be added.
+     * @throws std::length_error if the player already has kZobristMaxPotions potions of its type,
+     * the highest count with a Zobrist key.
      */
     void addPotion(const Potion &potion);
 
@@ -95,10 +142,31 @@ public:
      * @brief Uses a potion of the specified type on the target slime.
      * @param type The type of potion to use.
      * @param target Pointer to the target slime (can be nullptr for certain potion types).
-     * @return true if the potion was successfully used, false otherwise.
+     * @return true if the potion was successfully used, false if there was none left or a revival potion found no beaten slime.
      */
     bool usePotion(Potion::Type type, Slime *target);
 
+    /**
+     * @brief Marks the last used potion of the given type as unused again.
+     * @details Only the potion is given back, the effects of using it are undone by the caller.
+     * @param type The type of potion to give back.
+     */
+    void restorePotion(Potion::Type type);
+
+    /**
+     * @brief Sets how many potions of a type are left, marking the others as used.
+     * @param type The type of potion.
+     * @param count The number of unused potions, at most the number of potions of that type.
+     */
+    void setUnusedPotions(Potion::Type type, int count);
+
+    /**
+     * @brief Puts the player back to the start of a game, keeping its slimes, potions and strategy.
+     * @details Every slime gets its full HP and loses its attack boost, every potion is unused again,
+     * no slime is active and the strategy forgets the previous game.
+     */
+    void reset();
+
     /**
      * @brief Checks if the player has unused revival potions.
      * @return true if a revival potion can be used, false otherwise.
@@ -111,10 +179,35 @@ public:
      */
     bool canUseAttackPotion() const;
 
+    /**
+     * @brief Gets the Zobrist hash of this player's half of the position.
+     * @details Kept up to date incrementally as slimes take damage, heal, get boosted,
+     * switch in and as potions are used. XOR both players' hashes for the whole position.
+     * @return The Zobrist hash of the player's slimes and potions.
+     */
+    uint64_t getHash() const { return hash; }
+
 private:
-    std::vector<Slime *> slimes; /**< Vector of pointers to the player's Slime objects */
-    Slime *activeSlime;          /**< Pointer to the currently active Slime */
     Strategy *strategy;          /**< Pointer to the Strategy object guiding the player's decisions */
+    BattleArena &arena;          /**< The arena of the battle, holding the slimes */
+    Slime *slimes;               /**< The player's slimes, room for kMaxTeamSize of them in the arena, nullptr after clearSlimes */
+    int slimeCount = 0;          /**< Number of slimes added */
+    Slime *activeSlime;          /**< Pointer to the currently active Slime */
+    DecisionProfiler *profiler = nullptr; /**< Profiler timing the strategy's decisions, or nullptr */
 
     std::vector<Potion> potions; /**< Vector of potions the player can use */
+    Side side = Side::Player;    /**< The side this player is playing on, selects its Zobrist keys */
+    uint64_t hash = 0;           /**< Zobrist hash of the player's half of the position */
+
+    /**
+     * @brief Recomputes the Zobrist hash from scratch, after the roster or the side changed.
+     */
+    void rehash();
+
+    /**
+     * @brief Counts the unused potions of a type.
+     * @param type The type of potion.
+     * @return The number of unused potions of that type.
+     */
+    int countPotions(Potion::Type type) const;
 };
\ No newline at end of file
@@ -40,6 +40,11 @@ public:
      */
     void use() const { used = true; }
 
+    /**
+     * @brief Mark the potion as unused again, e.g. when a turn is undone.
+     */
+    void reset() const { used = false; }
+
 private:
     Type type;         ///< The type of the potion.
     mutable bool used; ///< Tracks whether the potion has been used.
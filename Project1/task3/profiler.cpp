@@ -0,0 +1,139 @@
+#include "profiler.h"
+#include <algorithm>
+#include <iomanip>
+
+int LatencyHistogram::bucketOf(uint64_t value)
+{
+    // values below kSubBuckets get a bucket each, above that each power of two is split in kSubBuckets
+    if (value < static_cast<uint64_t>(kSubBuckets))
+    {
+        return static_cast<int>(value);
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    int sub = static_cast<int>(value >> (exponent - kSubBucketBits)) - kSubBuckets;
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketStart(int bucket)
+{
+    if (bucket < kSubBuckets)
+    {
+        return static_cast<uint64_t>(bucket);
+    }
+    int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % kSubBuckets + kSubBuckets);
+    // the end of the last bucket is one past the largest value
+    return exponent >= 64 ? UINT64_MAX : sub << (exponent - kSubBucketBits);
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+    counts[bucketOf(nanoseconds)]++;
+    count++;
+    total += nanoseconds;
+    max = std::max(max, nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (int i = 0; i < kBucketCount; ++i)
+    {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    total += other.total;
+    max = std::max(max, other.max);
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count + 0.5);
+    rank = std::min(std::max<uint64_t>(rank, 1), count);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return std::min(max, bucketStart(i + 1) - 1);
+        }
+    }
+    return max;
+}
+
+DecisionProfiler::DecisionProfiler(std::ostream *report) : report(report) {}
+
+DecisionProfiler::StrategyHistograms &DecisionProfiler::histogramsOf(const char *strategy)
+{
+    for (StrategyHistograms &entry : strategies)
+    {
+        if (entry.strategy == strategy)
+        {
+            return entry;
+        }
+    }
+    strategies.emplace_back();
+    strategies.back().strategy = strategy;
+    return strategies.back();
+}
+
+void DecisionProfiler::record(const char *strategy, Decision decision, uint64_t nanoseconds)
+{
+    histogramsOf(strategy).histograms[static_cast<int>(decision)].record(nanoseconds);
+}
+
+void DecisionProfiler::merge(const DecisionProfiler &other)
+{
+    for (const StrategyHistograms &entry : other.strategies)
+    {
+        StrategyHistograms &own = histogramsOf(entry.strategy.c_str());
+        for (int d = 0; d < static_cast<int>(Decision::Count); ++d)
+        {
+            own.histograms[d].merge(entry.histograms[d]);
+        }
+    }
+}
+
+void DecisionProfiler::onGameEnd() const
+{
+    if (report)
+    {
+        print(*report);
+    }
+}
+
+void DecisionProfiler::print(std::ostream &out) const
+{
+    static const char *decisionNames[] = {"action", "starting slime", "next slime"};
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "Decision latency in microseconds\n";
+    out << std::left << std::setw(16) << "strategy" << std::setw(16) << "decision" << std::right << std::setw(10) << "count"
+        << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+        << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+    out << std::fixed << std::setprecision(2);
+    for (const StrategyHistograms &entry : strategies)
+    {
+        for (int d = 0; d < static_cast<int>(Decision::Count); ++d)
+        {
+            const LatencyHistogram &histogram = entry.histograms[d];
+            if (histogram.getCount() == 0)
+            {
+                continue;
+            }
+            out << std::left << std::setw(16) << entry.strategy << std::setw(16) << decisionNames[d] << std::right
+                << std::setw(10) << histogram.getCount() << std::setw(10) << histogram.getMean() / 1000.0;
+            for (double percentile : {50.0, 90.0, 99.0, 99.9})
+            {
+                out << std::setw(10) << histogram.getPercentile(percentile) / 1000.0;
+            }
+            out << std::setw(10) << histogram.getMax() / 1000.0 << "\n";
+        }
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
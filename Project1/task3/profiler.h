@@ -0,0 +1,152 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ * @brief A log-bucketed histogram of durations, in the spirit of HdrHistogram.
+ *
+ * Every power of two is split into kSubBuckets equal buckets, so any recorded value is known
+ * to within 1/kSubBuckets of itself, from nanoseconds to hours, in a fixed array of counters.
+ * Recording is a bit scan and an increment, cheap enough to time every decision of a game.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int kSubBucketBits = 3;                                     /**< log2 of the buckets per power of two */
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;                      /**< Buckets per power of two */
+    static constexpr int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets; /**< Buckets covering every 64-bit value */
+
+    /**
+     * @brief Records one duration.
+     * @param nanoseconds The duration.
+     */
+    void record(uint64_t nanoseconds);
+
+    /**
+     * @brief Adds every value recorded by another histogram.
+     * @param other The histogram to add.
+     */
+    void merge(const LatencyHistogram &other);
+
+    /**
+     * @brief Gets the number of recorded values.
+     * @return The count.
+     */
+    uint64_t getCount() const { return count; }
+
+    /**
+     * @brief Gets the mean of the recorded values, exact rather than bucketed.
+     * @return The mean in nanoseconds, 0 if nothing was recorded.
+     */
+    double getMean() const { return count ? static_cast<double>(total) / count : 0.0; }
+
+    /**
+     * @brief Gets the largest recorded value, exact rather than bucketed.
+     * @return The maximum in nanoseconds.
+     */
+    uint64_t getMax() const { return max; }
+
+    /**
+     * @brief Gets a percentile of the recorded values.
+     * @param percentile The percentile, between 0 and 100.
+     * @return The highest value of the bucket holding the percentile, in nanoseconds, at most the maximum.
+     */
+    uint64_t getPercentile(double percentile) const;
+
+private:
+    uint64_t counts[kBucketCount] = {}; /**< Number of values in each bucket */
+    uint64_t count = 0;                 /**< Number of recorded values */
+    uint64_t total = 0;                 /**< Sum of the recorded values */
+    uint64_t max = 0;                   /**< Largest recorded value */
+
+    /**
+     * @brief Finds the bucket of a value.
+     * @param value The value.
+     * @return The index of its bucket.
+     */
+    static int bucketOf(uint64_t value);
+
+    /**
+     * @brief Gets the smallest value of a bucket.
+     * @param bucket The index of the bucket, up to kBucketCount for the end of the last bucket.
+     * @return The lowest value that falls in the bucket.
+     */
+    static uint64_t bucketStart(int bucket);
+};
+
+/**
+ * @enum Decision
+ * @brief The decisions a strategy is asked to make.
+ */
+enum class Decision
+{
+    Action,        ///< Player::chooseAction
+    StartingSlime, ///< Player::chooseStartingSlime
+    NextSlime,     ///< Player::chooseNextSlime
+    Count          ///< Number of decision kinds
+};
+
+/**
+ * @class DecisionProfiler
+ * @brief Times the decisions of the players it is attached to, one histogram per strategy and decision kind.
+ *
+ * Attach it with Engine::setProfiler. A profiler is not thread-safe: give each thread its own
+ * and merge them once the threads are done.
+ */
+class DecisionProfiler
+{
+public:
+    /**
+     * @brief Constructs a new DecisionProfiler.
+     * @param report Stream the histograms are printed to at the end of every runGame, nullptr to print them on demand only.
+     */
+    explicit DecisionProfiler(std::ostream *report = nullptr);
+
+    /**
+     * @brief Records the duration of one decision.
+     * @param strategy Name of the strategy that decided, as returned by Strategy::getName.
+     * @param decision The kind of decision.
+     * @param nanoseconds How long the decision took.
+     */
+    void record(const char *strategy, Decision decision, uint64_t nanoseconds);
+
+    /**
+     * @brief Adds every duration recorded by another profiler.
+     * @param other The profiler to add.
+     */
+    void merge(const DecisionProfiler &other);
+
+    /**
+     * @brief Called by the engine when a game ends, prints the histograms if a report stream was given.
+     */
+    void onGameEnd() const;
+
+    /**
+     * @brief Prints the count, mean, percentiles and maximum of every histogram, in microseconds.
+     * @param out The stream to print to.
+     */
+    void print(std::ostream &out) const;
+
+private:
+    /**
+     * @brief The histograms of one strategy.
+     */
+    struct StrategyHistograms
+    {
+        std::string strategy;                                             /**< Name of the strategy */
+        LatencyHistogram histograms[static_cast<int>(Decision::Count)]; /**< One histogram per kind of decision */
+    };
+
+    std::vector<StrategyHistograms> strategies; /**< Histograms of every strategy seen so far, in order of appearance */
+    std::ostream *report;                       /**< Stream printed to at the end of every game, or nullptr */
+
+    /**
+     * @brief Finds the histograms of a strategy, adding them on first use.
+     * @param strategy Name of the strategy.
+     * @return The histograms.
+     */
+    StrategyHistograms &histogramsOf(const char *strategy);
+};
@@ -0,0 +1,75 @@
+#include "rng.h"
+
+// multipliers and Weyl key increments of Philox4x32, from Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"
+static const uint32_t kPhiloxM0 = 0xD2511F53u;
+static const uint32_t kPhiloxM1 = 0xCD9E8D57u;
+static const uint32_t kPhiloxW0 = 0x9E3779B9u;
+static const uint32_t kPhiloxW1 = 0xBB67AE85u;
+static const int kPhiloxRounds = 10;
+
+Rng::Rng(uint64_t seed, uint64_t stream)
+    : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, stream(stream), counter(0), block{}, used(4) {}
+
+void Rng::philox(uint32_t counter[4], const uint32_t key[2])
+{
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    for (int round = 0; round < kPhiloxRounds; ++round)
+    {
+        uint64_t product0 = static_cast<uint64_t>(kPhiloxM0) * counter[0];
+        uint64_t product1 = static_cast<uint64_t>(kPhiloxM1) * counter[2];
+        uint32_t c0 = static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ k0;
+        uint32_t c1 = static_cast<uint32_t>(product1);
+        uint32_t c2 = static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ k1;
+        uint32_t c3 = static_cast<uint32_t>(product0);
+        counter[0] = c0;
+        counter[1] = c1;
+        counter[2] = c2;
+        counter[3] = c3;
+        k0 += kPhiloxW0;
+        k1 += kPhiloxW1;
+    }
+}
+
+uint32_t Rng::nextUInt32()
+{
+    if (used == 4)
+    {
+        block[0] = static_cast<uint32_t>(counter);
+        block[1] = static_cast<uint32_t>(counter >> 32);
+        block[2] = static_cast<uint32_t>(stream);
+        block[3] = static_cast<uint32_t>(stream >> 32);
+        philox(block, key);
+        counter++;
+        used = 0;
+    }
+    return block[used++];
+}
+
+uint64_t Rng::nextUInt64()
+{
+    uint64_t high = nextUInt32();
+    return (high << 32) | nextUInt32();
+}
+
+uint32_t Rng::uniformInt(uint32_t bound)
+{
+    // Lemire's multiply-shift, redrawing the few values that would make some results more likely
+    uint64_t product = static_cast<uint64_t>(nextUInt32()) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            product = static_cast<uint64_t>(nextUInt32()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+double Rng::uniformReal()
+{
+    return (nextUInt64() >> 11) * 0x1.0p-53;
+}
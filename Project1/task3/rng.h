@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @class Rng
+ * @brief Counter-based random number generator (Philox4x32-10).
+ *
+ * Every block of four 32-bit outputs is a pure function of the key (the master seed),
+ * the stream number and the block counter, so a generator carries no hidden state
+ * beyond its position. Seeding one generator per game from (master seed, game index)
+ * gives every game its own independent stream: a multithreaded run plays the same
+ * games whatever the thread count, and any single game can be replayed on its own.
+ * A generator is not thread-safe, each game owns one and hands it out by reference.
+ */
+class Rng
+{
+public:
+    /**
+     * @brief Constructs a new Rng at the start of a stream.
+     * @param seed The master seed.
+     * @param stream The stream number, e.g. the index of a game.
+     */
+    explicit Rng(uint64_t seed = 0, uint64_t stream = 0);
+
+    /**
+     * @brief Draws 32 random bits.
+     * @return The next output of the stream.
+     */
+    uint32_t nextUInt32();
+
+    /**
+     * @brief Draws 64 random bits.
+     * @return The next two outputs of the stream combined.
+     */
+    uint64_t nextUInt64();
+
+    /**
+     * @brief Draws a uniformly distributed integer, without modulo bias.
+     * @param bound The number of possible values, at least 1.
+     * @return An integer in [0, bound).
+     */
+    uint32_t uniformInt(uint32_t bound);
+
+    /**
+     * @brief Draws a uniformly distributed real number.
+     * @return A double in [0, 1) with 53 random bits.
+     */
+    double uniformReal();
+
+    /**
+     * @brief Computes one Philox4x32-10 block.
+     * @param counter The 128-bit counter, as four 32-bit words, overwritten with the output.
+     * @param key The 64-bit key, as two 32-bit words.
+     */
+    static void philox(uint32_t counter[4], const uint32_t key[2]);
+
+private:
+    uint32_t key[2];   /**< The master seed */
+    uint64_t stream;   /**< The stream number, the upper half of the counter */
+    uint64_t counter;  /**< Index of the next block, the lower half of the counter */
+    uint32_t block[4]; /**< The current block of outputs */
+    int used;          /**< Number of outputs of the current block already drawn */
+};
@@ -0,0 +1,22 @@
+#include "roster.h"
+#include "player.h"
+
+void addStandardSlimes(Player &player)
+{
+    for (const RosterEntry &entry : kStandardRoster)
+    {
+        player.addSlime(Slime(entry.name, entry.type, entry.maxHP, entry.attack, entry.defense, entry.speed));
+    }
+}
+
+void addStandardPotions(Player &player)
+{
+    for (int i = 0; i < kStandardRevivalPotions; ++i)
+    {
+        player.addPotion(Potion(Potion::Type::Revival));
+    }
+    for (int i = 0; i < kStandardAttackPotions; ++i)
+    {
+        player.addPotion(Potion(Potion::Type::Attack));
+    }
+}
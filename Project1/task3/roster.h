@@ -0,0 +1,42 @@
+#pragma once
+#include "slime.h"
+
+class Player;
+
+/**
+ * @brief Stats of one slime of a roster.
+ */
+struct RosterEntry
+{
+    const char *name; /**< The name of the slime */
+    SlimeType type;   /**< The type of the slime */
+    int maxHP;        /**< The maximum hit points of the slime */
+    int attack;       /**< The attack stat of the slime */
+    int defense;      /**< The defense stat of the slime */
+    int speed;        /**< The speed stat of the slime */
+};
+
+/**
+ * @brief The standard team every player brings: Green, Red and Blue.
+ */
+constexpr RosterEntry kStandardRoster[] = {
+    {"Green", SlimeType::Grass, 110, 10, 10, 10},
+    {"Red", SlimeType::Fire, 100, 11, 10, 11},
+    {"Blue", SlimeType::Water, 100, 10, 11, 9},
+};
+
+constexpr int kStandardTeamSize = sizeof(kStandardRoster) / sizeof(kStandardRoster[0]); /**< Number of slimes in the standard team */
+constexpr int kStandardRevivalPotions = 1; /**< Revival potions in the standard potion set */
+constexpr int kStandardAttackPotions = 2;  /**< Attack potions in the standard potion set */
+
+/**
+ * @brief Adds the standard team (Green, Red and Blue) to a player.
+ * @param player The player receiving the slimes.
+ */
+void addStandardSlimes(Player &player);
+
+/**
+ * @brief Adds the standard potion set (one revival and two attack potions) to a player.
+ * @param player The player receiving the potions.
+ */
+void addStandardPotions(Player &player);
@@ -0,0 +1,105 @@
+#pragma once
+#include "type_chart.h"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Names a rule set at run time, e.g. the one an Engine plays by.
+ */
+enum class RuleSet : uint8_t
+{
+    Task1, /**< See Task1Rules */
+    Task2, /**< See Task2Rules */
+    Task3  /**< See Task3Rules */
+};
+
+/**
+ * @brief The rules of task 1: no potions, and the damage formula of the first engine.
+ * @details A rule set is a policy class read at compile time by the templated Engine turn code,
+ * by BattleSetup::fromPlayers and by the searching strategies, so every rule set compiles to
+ * its own specialised turn code, with the branches of the rules it leaves out removed.
+ */
+struct Task1Rules
+{
+    static constexpr const char *kName = "task1"; /**< Name of the rule set, as printed by the benchmarks */
+    static constexpr RuleSet kRuleSet = RuleSet::Task1; /**< Run-time name of the rule set */
+    static constexpr bool kPotions = false;        /**< Whether the sides may use potions */
+    static constexpr int kRoundLimit = 100;        /**< The game is a draw once this round is reached */
+
+    /**
+     * @brief Calculates the damage of an attack from raw stats.
+     * @details power * attack / defense rounded down, times the effectiveness, rounded half up and at least 1,
+     * which is what the original float formula of task 1 and task 2 gives, computed in integers only.
+     * @param power The power of the skill.
+     * @param skillType The type of the skill.
+     * @param attack The attack stat of the attacker.
+     * @param defense The defense stat of the defender.
+     * @param defenderType The type of the defender.
+     * @return The calculated damage.
+     */
+    static int damage(int power, SkillType skillType, int attack, int defense, SlimeType defenderType)
+    {
+        int base = power * attack / defense;
+        return std::max(1, (base * TypeChart::halves(skillType, defenderType) + 1) / 2);
+    }
+};
+
+/**
+ * @brief The rules of task 2, the same as task 1's; only the opponent's strategy changes.
+ */
+struct Task2Rules : Task1Rules
+{
+    static constexpr const char *kName = "task2"; /**< Name of the rule set, as printed by the benchmarks */
+    static constexpr RuleSet kRuleSet = RuleSet::Task2; /**< Run-time name of the rule set */
+};
+
+/**
+ * @brief The rules of task 3: potions and attack boosts, and the damage rounded once at the end.
+ */
+struct Task3Rules
+{
+    static constexpr const char *kName = "task3"; /**< Name of the rule set, as printed by the benchmarks */
+    static constexpr RuleSet kRuleSet = RuleSet::Task3; /**< Run-time name of the rule set */
+    static constexpr bool kPotions = true;         /**< Whether the sides may use potions */
+    static constexpr int kRoundLimit = 100;        /**< The game is a draw once this round is reached */
+
+    /**
+     * @brief Calculates the damage of an attack from raw stats, see Engine::calculateDamage.
+     * @param power The power of the skill.
+     * @param skillType The type of the skill.
+     * @param attack The attack stat of the attacker (already doubled if boosted).
+     * @param defense The defense stat of the defender.
+     * @param defenderType The type of the defender.
+     * @return The calculated damage.
+     */
+    static int damage(int power, SkillType skillType, int attack, int defense, SlimeType defenderType)
+    {
+        // power * attack * effectiveness / defense rounded half up, with the effectiveness in halves:
+        // all in integers, so every compiler and every set of flags gives the same damage
+        int halves = TypeChart::halves(skillType, defenderType);
+        return std::max(1, (power * attack * halves + defense) / (2 * defense));
+    }
+};
+
+/**
+ * @brief Calls a function with the rules struct of a rule set named at run time.
+ * @details Lets code holding a RuleSet, such as the Engine and the searching strategies, branch
+ * once per turn or decision into code compiled for that rule set.
+ * @param rules The rule set.
+ * @param function A generic callable taking the rules struct, e.g. [&](auto rules) { ... decltype(rules)::kRoundLimit ... }.
+ * @return What the function returns, which must be the same type for every rule set.
+ */
+template <typename Function>
+decltype(auto) withRules(RuleSet rules, Function &&function)
+{
+    switch (rules)
+    {
+    case RuleSet::Task1:
+        return function(Task1Rules{});
+    case RuleSet::Task2:
+        return function(Task2Rules{});
+    case RuleSet::Task3:
+        break;
+    }
+    return function(Task3Rules{});
+}
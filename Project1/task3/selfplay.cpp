@@ -0,0 +1,472 @@
+#include "engine.h"
+#include "player.h"
+#include "strategy.h"
+#include "roster.h"
+#include "rng.h"
+#include "exact_analysis.h"
+#include "profiler.h"
+#include "trace.h"
+#include "perf_counters.h"
+#include "allocation.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <optional>
+
+/**
+ * @brief Results of a batch of bot-vs-bot games, counted from the player's side.
+ */
+struct SelfPlayStats
+{
+    long long wins = 0;        /**< Games won by the player's strategy */
+    long long losses = 0;      /**< Games won by the enemy's strategy */
+    long long draws = 0;       /**< Games that reached the round limit */
+    long long totalRounds = 0; /**< Sum of the round counts of all games */
+    long long simulatedTurns = 0; /**< Turns simulated by searching strategies, such as MCTS rollouts */
+    AllocationStats allocations[static_cast<int>(AllocationPhase::Count)]; /**< Heap allocations of each phase of the games */
+
+    void add(const SelfPlayStats &other)
+    {
+        for (int p = 0; p < static_cast<int>(AllocationPhase::Count); ++p)
+        {
+            allocations[p].add(other.allocations[p]);
+        }
+        wins += other.wins;
+        losses += other.losses;
+        draws += other.draws;
+        totalRounds += other.totalRounds;
+        simulatedTurns += other.simulatedTurns;
+    }
+};
+
+/**
+ * @brief The players, strategies and engine of a game, reset and reused for every game a thread plays.
+ * @details Building them costs about as much as a whole game between the cheap strategies, and a
+ * reset battle plays exactly like a new one. Only the rosters are rebuilt for every game: the previous
+ * game's slimes are torn down with one arena reset and copies of the standard slimes placed again.
+ */
+struct Battle
+{
+    Strategy *playerStrategy; /**< The player's strategy, owned by player */
+    Strategy *enemyStrategy;  /**< The enemy's strategy, owned by enemy */
+    BattleArena arena;        /**< Storage of both rosters */
+    Player player;            /**< The player */
+    Player enemy;             /**< The enemy */
+    Rng rng;                  /**< Generator of the current game, reseeded for every game */
+    Engine engine;            /**< The engine playing the games */
+    std::vector<Slime> roster; /**< The standard slimes, built once and copied into the arena for every game */
+
+    /**
+     * @brief Sets up a battle: both sides get the standard slimes and the task 3 potions.
+     * @details Strategies that don't use potions simply ignore them. With a profiler, every decision
+     * of both strategies is timed.
+     */
+    Battle(const std::string &playerName, const std::string &enemyName, int criticalChance, BattleObserver &observer,
+           DecisionProfiler *profiler)
+        : playerStrategy(createStrategy(playerName)), enemyStrategy(createStrategy(enemyName)),
+          player(playerStrategy, arena), enemy(enemyStrategy, arena), engine(player, enemy, observer)
+    {
+        addStandardPotions(player);
+        addStandardPotions(enemy);
+        for (const RosterEntry &entry : kStandardRoster)
+        {
+            roster.push_back(Slime(entry.name, entry.type, entry.maxHP, entry.attack, entry.defense, entry.speed));
+        }
+        rebuildTeams();
+        engine.setRng(rng);
+        engine.setCriticalChance(criticalChance);
+        if (profiler)
+        {
+            engine.setProfiler(*profiler);
+        }
+    }
+
+    /**
+     * @brief Tears down both rosters with a single arena reset and places the standard slimes again.
+     */
+    void rebuildTeams()
+    {
+        player.clearSlimes();
+        enemy.clearSlimes();
+        arena.reset();
+        for (const Slime &slime : roster)
+        {
+            player.addSlime(slime);
+        }
+        for (const Slime &slime : roster)
+        {
+            enemy.addSlime(slime);
+        }
+    }
+};
+
+/**
+ * @brief Plays one game on a battle and adds its result to the statistics.
+ * @details The battle is reset and gets the game's own random stream, so the game plays the same
+ * whichever thread runs it, and it can be replayed on its own from the master seed and its index.
+ * The allocations of the calling thread are counted in the setup, game and teardown phases,
+ * the last running until the next game.
+ */
+static void playGame(Battle &battle, uint64_t masterSeed, long long gameIndex, SelfPlayStats &stats)
+{
+    AllocationTracker::setPhase(AllocationPhase::Setup);
+    Engine &engine = battle.engine;
+    battle.rng = Rng(masterSeed, static_cast<uint64_t>(gameIndex));
+    battle.rebuildTeams();
+    engine.reset();
+    engine.startGame();
+    AllocationTracker::setPhase(AllocationPhase::Game);
+    engine.runGame();
+    AllocationTracker::setPhase(AllocationPhase::Teardown);
+
+    switch (engine.getResult())
+    {
+    case GameResult::Win:
+        stats.wins++;
+        break;
+    case GameResult::Lose:
+        stats.losses++;
+        break;
+    case GameResult::Draw:
+        stats.draws++;
+        break;
+    }
+    stats.totalRounds += engine.getRound();
+    for (const Strategy *strategy : {battle.playerStrategy, battle.enemyStrategy})
+    {
+        if (const MCTSStrategy *mcts = dynamic_cast<const MCTSStrategy *>(strategy))
+        {
+            stats.simulatedTurns += mcts->getSimulatedTurns();
+        }
+    }
+}
+
+/**
+ * @brief Plays games until the shared game counter reaches the requested number of games.
+ * @details The thread reuses one battle for all its games, unless fresh asks for a new one per game.
+ * With a reading, the thread's performance counters run around its whole share of the batch.
+ */
+static void playGames(const std::string &playerName, const std::string &enemyName, uint64_t masterSeed, long long games,
+                      int criticalChance, bool fresh, std::atomic<long long> &nextGame, DecisionProfiler *profiler,
+                      PerfReading *perf, SelfPlayStats &stats)
+{
+    NullObserver observer;
+    // the counters open their perf_event descriptors when constructed, so only with --perf
+    std::optional<PerfCounters> counters;
+    AllocationTracker::reset();
+    if (perf)
+    {
+        counters.emplace();
+        counters->start();
+    }
+    std::unique_ptr<Battle> battle;
+    long long game;
+    while ((game = nextGame.fetch_add(1)) < games)
+    {
+        if (!battle || fresh)
+        {
+            // the old battle goes in the previous game's teardown, the new one in this game's setup
+            battle.reset();
+            AllocationTracker::setPhase(AllocationPhase::Setup);
+            battle = std::make_unique<Battle>(playerName, enemyName, criticalChance, observer, profiler);
+        }
+        playGame(*battle, masterSeed, game, stats);
+    }
+    if (perf)
+    {
+        counters->stop();
+        *perf = counters->read();
+    }
+    for (int p = 0; p < static_cast<int>(AllocationPhase::Count); ++p)
+    {
+        stats.allocations[p] = AllocationTracker::getStats(static_cast<AllocationPhase>(p));
+    }
+}
+
+/**
+ * @brief Computes the exact result distribution of the matchup with an ExactAnalyzer and prints it.
+ * @details The players are set up as in playGame, the starting slimes are chosen with the given seed.
+ */
+static void analyzeExact(const std::string &playerName, const std::string &enemyName, uint64_t masterSeed, int criticalChance)
+{
+    Strategy *playerStrategy = createStrategy(playerName);
+    Strategy *enemyStrategy = createStrategy(enemyName);
+    BattleArena arena;
+    Player player(playerStrategy, arena);
+    Player enemy(enemyStrategy, arena);
+    addStandardPotions(player);
+    addStandardPotions(enemy);
+    addStandardSlimes(player);
+    addStandardSlimes(enemy);
+
+    NullObserver observer;
+    Rng rng(masterSeed);
+    Engine engine(player, enemy, observer);
+    engine.setRng(rng);
+    engine.setCriticalChance(criticalChance);
+    engine.startGame();
+
+    auto start = std::chrono::steady_clock::now();
+    ExactAnalyzer analyzer(engine, player, enemy);
+    ExactResult result = analyzer.analyze();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << playerName << " vs " << enemyName << ": exact distribution, critical chance " << criticalChance << "%" << std::endl;
+    std::cout << "Win: " << result.win << ", Lose: " << result.lose << ", Draw: " << result.draw << std::endl;
+    std::cout << "Expected rounds: " << result.expectedRounds << std::endl;
+    std::cout << "Most states in a round: " << result.maxStates << std::endl;
+    std::cout << "Time: " << seconds * 1000 << " ms" << std::endl;
+}
+
+/**
+ * @brief Writes the recorded spans to a Chrome trace file.
+ * @param path The file to write, nothing is written if it is empty.
+ * @return false if the file could not be written, true otherwise.
+ */
+static bool writeTrace(const std::string &path)
+{
+    if (path.empty())
+    {
+        return true;
+    }
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Cannot write " << path << std::endl;
+        return false;
+    }
+    size_t spans = Trace::writeJson(out);
+    std::cout << "Wrote " << spans << " spans to " << path << std::endl;
+    return true;
+}
+
+static int usage(const char *program)
+{
+    std::cerr << "Usage: " << program << " <player-strategy> <enemy-strategy> [games] [threads] [--seed seed] [--replay game]"
+              << " [--crit percent] [--exact] [--fresh] [--latency] [--trace file] [--perf] [--alloc] [--alloc-check]" << std::endl;
+    std::cerr << "Strategies: simple, greedy, potion-greedy, search, mcts" << std::endl;
+    std::cerr << "--replay prints the battle of one game of the batch, as played with the same seed" << std::endl;
+    std::cerr << "--crit sets the chance of critical hits, which deal double damage" << std::endl;
+    std::cerr << "--exact computes the exact result probabilities instead of playing games" << std::endl;
+    std::cerr << "--fresh builds new players and a new engine for every game instead of resetting one per thread" << std::endl;
+    std::cerr << "--latency prints histograms of the time each strategy takes per decision" << std::endl;
+    std::cerr << "--trace writes the engine's spans as Chrome trace events, needs a build with make TRACE=1" << std::endl;
+    std::cerr << "--perf prints hardware performance counters per game, where the kernel and CPU provide them" << std::endl;
+    std::cerr << "--alloc prints the heap allocations per game of the setup, game and teardown phases" << std::endl;
+    std::cerr << "--alloc-check fails if any game allocates between the end of startGame and the end of runGame" << std::endl;
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        return usage(argv[0]);
+    }
+
+    std::string playerName = argv[1];
+    std::string enemyName = argv[2];
+    std::vector<std::string> positional;
+    uint64_t masterSeed = 0;
+    long long replayGame = -1;
+    int criticalChance = 0;
+    bool exact = false;
+    bool fresh = false;
+    bool latency = false;
+    std::string tracePath;
+    bool perf = false;
+    bool alloc = false;
+    bool allocCheck = false;
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc)
+        {
+            masterSeed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replayGame = std::atoll(argv[++i]);
+        }
+        else if (arg == "--crit" && i + 1 < argc)
+        {
+            criticalChance = std::atoi(argv[++i]);
+        }
+        else if (arg == "--exact")
+        {
+            exact = true;
+        }
+        else if (arg == "--fresh")
+        {
+            fresh = true;
+        }
+        else if (arg == "--latency")
+        {
+            latency = true;
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (arg == "--perf")
+        {
+            perf = true;
+        }
+        else if (arg == "--alloc")
+        {
+            alloc = true;
+        }
+        else if (arg == "--alloc-check")
+        {
+            allocCheck = true;
+        }
+        else if (arg.compare(0, 2, "--") == 0)
+        {
+            return usage(argv[0]);
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+    long long games = positional.size() > 0 ? std::atoll(positional[0].c_str()) : 10000;
+    int threadCount = positional.size() > 1 ? std::atoi(positional[1].c_str()) : static_cast<int>(std::thread::hardware_concurrency());
+    if (threadCount < 1)
+    {
+        threadCount = 1;
+    }
+
+    // make sure both names are valid before starting any thread
+    for (const std::string &name : {playerName, enemyName})
+    {
+        Strategy *strategy = createStrategy(name);
+        if (!strategy)
+        {
+            std::cerr << "Unknown strategy: " << name << std::endl;
+            return usage(argv[0]);
+        }
+        delete strategy;
+    }
+
+    if (criticalChance < 0 || criticalChance > 100)
+    {
+        std::cerr << "The critical chance must be between 0 and 100" << std::endl;
+        return usage(argv[0]);
+    }
+
+    if (!tracePath.empty() && !Trace::isEnabled())
+    {
+        std::cerr << "This build records no spans, rebuild with make clean && make TRACE=1" << std::endl;
+        return 1;
+    }
+
+    if (replayGame >= 0)
+    {
+        TextObserver observer(std::cout);
+        SelfPlayStats stats;
+        DecisionProfiler profiler(&std::cout);
+        std::optional<PerfCounters> counters;
+        if (perf)
+        {
+            counters.emplace();
+            counters->start();
+        }
+        Battle battle(playerName, enemyName, criticalChance, observer, latency ? &profiler : nullptr);
+        playGame(battle, masterSeed, replayGame, stats);
+        if (perf)
+        {
+            counters->stop();
+            counters->read().print(std::cout, 1, "game");
+        }
+        return writeTrace(tracePath) ? 0 : 1;
+    }
+
+    if (exact)
+    {
+        analyzeExact(playerName, enemyName, masterSeed, criticalChance);
+        return 0;
+    }
+
+    std::atomic<long long> nextGame(0);
+    std::vector<SelfPlayStats> threadStats(threadCount);
+    std::vector<DecisionProfiler> threadProfilers(threadCount);
+    std::vector<PerfReading> threadPerf(threadCount);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(playGames, playerName, enemyName, masterSeed, games, criticalChance, fresh, std::ref(nextGame),
+                             latency ? &threadProfilers[i] : nullptr, perf ? &threadPerf[i] : nullptr, std::ref(threadStats[i]));
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SelfPlayStats total;
+    for (const SelfPlayStats &stats : threadStats)
+    {
+        total.add(stats);
+    }
+
+    std::cout << playerName << " vs " << enemyName << ": " << games << " games on " << threadCount << " threads, seed " << masterSeed;
+    if (criticalChance > 0)
+    {
+        std::cout << ", critical chance " << criticalChance << "%";
+    }
+    std::cout << std::endl;
+    std::cout << "Wins: " << total.wins << ", Losses: " << total.losses << ", Draws: " << total.draws << std::endl;
+    std::cout << "Average rounds: " << (games > 0 ? double(total.totalRounds) / games : 0.0) << std::endl;
+    std::cout << "Games per second: " << (seconds > 0 ? games / seconds : 0.0) << std::endl;
+    if (total.simulatedTurns > 0)
+    {
+        std::cout << "Simulated turns per second: " << (seconds > 0 ? total.simulatedTurns / seconds : 0.0) << std::endl;
+    }
+    if (latency)
+    {
+        DecisionProfiler profiler;
+        for (const DecisionProfiler &threadProfiler : threadProfilers)
+        {
+            profiler.merge(threadProfiler);
+        }
+        profiler.print(std::cout);
+    }
+    if (perf)
+    {
+        PerfReading reading;
+        for (const PerfReading &threadReading : threadPerf)
+        {
+            reading.add(threadReading);
+        }
+        reading.print(std::cout, games, "game");
+    }
+    if (alloc || allocCheck)
+    {
+        AllocationTracker::print(std::cout, total.allocations, games);
+    }
+    if (!writeTrace(tracePath))
+    {
+        return 1;
+    }
+    if (allocCheck)
+    {
+        long long gameAllocations = total.allocations[static_cast<int>(AllocationPhase::Game)].allocations;
+        if (!AllocationTracker::isHooked() || gameAllocations > 0)
+        {
+            std::cerr << "Allocation check failed: " << (AllocationTracker::isHooked() ? std::to_string(gameAllocations) + " allocations after startGame"
+                                                                                       : std::string("allocations are not counted")) << std::endl;
+            return 1;
+        }
+        std::cout << "Allocation check passed: no allocations after startGame" << std::endl;
+    }
+
+    return 0;
+}
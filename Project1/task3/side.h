@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * @brief Enumeration of the two sides taking part in a battle.
+ */
+enum class Side
+{
+    Player, /**< The human player (or the bot standing in for them) */
+    Enemy   /**< The AI opponent */
+};
@@ -1,9 +1,22 @@
 #include "skill.h"
 
-Skill::Skill(const std::string &name, SkillType type, int power, int accuracy, int priority)
-    : name(name), type(type), power(power), accuracy(accuracy), priority(priority) {}
+Skill::Skill(std::string_view name, SkillType type, int power, int accuracy, int priority)
+    : name(NameTable::intern(name)), type(type), power(power), accuracy(accuracy), priority(priority) {}
 
-std::string Skill::getName() const { return name; }
+const Skill &Skill::get(SkillId id)
+{
+    // built on first use, in the order of SkillId
+    static const Skill skills[] = {
+        Skill("Tackle", SkillType::Normal, 20, 100, 0),
+        Skill("Leaf", SkillType::Grass, 20, 100, 0),
+        Skill("Flame", SkillType::Fire, 20, 100, 0),
+        Skill("Stream", SkillType::Water, 20, 100, 0),
+    };
+    static_assert(sizeof(skills) / sizeof(skills[0]) == static_cast<size_t>(SkillId::Count), "one skill per SkillId");
+    return skills[static_cast<int>(id)];
+}
+
+std::string_view Skill::getName() const { return NameTable::get(name); }
 SkillType Skill::getType() const { return type; }
 int Skill::getPower() const { return power; }
 int Skill::getAccuracy() const { return accuracy; }
@@ -1,5 +1,10 @@
 #pragma once
-#include <string>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include "names.h"
+#include "team_config.h"
 
 /**
  * @brief Enumeration of possible skill types in the game.
@@ -9,7 +14,20 @@ enum class SkillType
     Normal, /**< Normal type skill */
     Grass,  /**< Grass type skill */
     Fire,   /**< Fire type skill */
-    Water   /**< Water type skill */
+    Water,  /**< Water type skill */
+    Count   /**< Number of skill types, not a type itself */
+};
+
+/**
+ * @brief The skills of the game, see Skill::get.
+ */
+enum class SkillId
+{
+    Tackle, /**< Normal skill every slime knows */
+    Leaf,   /**< Grass slimes' type skill */
+    Flame,  /**< Fire slimes' type skill */
+    Stream, /**< Water slimes' type skill */
+    Count   /**< Number of skills, not a skill itself */
 };
 
 /**
@@ -17,7 +35,8 @@ enum class SkillType
  * @brief Represents a skill that can be used by slimes in battle.
  *
  * This class encapsulates the properties of a skill, including its name,
- * type, power, accuracy, and priority.
+ * type, power, accuracy, and priority. Skills never change, so every slime
+ * refers to the shared instances returned by get instead of holding copies.
  */
 class Skill
 {
@@ -30,13 +49,26 @@ public:
      * @param accuracy The accuracy of the skill, affecting its hit chance.
      * @param priority The priority of the skill, determining its execution order.
      */
-    Skill(const std::string &name, SkillType type, int power, int accuracy, int priority);
+    Skill(std::string_view name, SkillType type, int power, int accuracy, int priority);
+
+    /**
+     * @brief Gets one of the shared skills of the game.
+     * @param id The skill.
+     * @return The skill, valid until the program ends.
+     */
+    static const Skill &get(SkillId id);
 
     /**
      * @brief Gets the name of the skill.
-     * @return The name of the skill.
+     * @return The name of the skill, from the NameTable.
+     */
+    std::string_view getName() const;
+
+    /**
+     * @brief Gets the interned name of the skill.
+     * @return The id of the name in the NameTable.
      */
-    std::string getName() const;
+    NameId getNameId() const { return name; }
 
     /**
      * @brief Gets the type of the skill.
@@ -63,9 +95,69 @@ public:
     int getPriority() const;
 
 private:
-    std::string name; /**< The name of the skill */
+    NameId name;      /**< The interned name of the skill */
     SkillType type;   /**< The type of the skill */
     int power;        /**< The power of the skill */
     int accuracy;     /**< The accuracy of the skill */
     int priority;     /**< The priority of the skill */
+};
+
+/**
+ * @class SkillList
+ * @brief A read-only list of shared skills, such as a species' skills.
+ *
+ * With a fixed skill count the list holds its skill pointers in a std::array and its size is a
+ * compile-time constant, otherwise it is a view of an array of skill pointers.
+ */
+class SkillList
+{
+public:
+    /**
+     * @brief Constructs a list of skills.
+     * @param skills The skills, the array must outlive the list.
+     * @param count Number of skills in the list.
+     * @throws std::length_error if the skill count is fixed and count differs from it.
+     */
+    SkillList(const Skill *const *skills, size_t count)
+#if SLIME_SKILL_COUNT > 0
+    {
+        if (count != kFixedSkillCount)
+        {
+            throw std::length_error("slime does not have SLIME_SKILL_COUNT skills");
+        }
+        for (size_t i = 0; i < kFixedSkillCount; ++i)
+        {
+            this->skills[i] = skills[i];
+        }
+    }
+#else
+        : skills(skills), count(count)
+    {
+    }
+#endif
+
+    /**
+     * @brief Gets the number of skills.
+     * @return The number of skills in the list.
+     */
+#if SLIME_SKILL_COUNT > 0
+    static constexpr size_t size() { return kFixedSkillCount; }
+#else
+    size_t size() const { return count; }
+#endif
+
+    /**
+     * @brief Gets a skill of the list.
+     * @param index The index of the skill, less than size().
+     * @return The skill.
+     */
+    const Skill &operator[](size_t index) const { return *skills[index]; }
+
+private:
+#if SLIME_SKILL_COUNT > 0
+    std::array<const Skill *, kFixedSkillCount> skills; /**< The skills */
+#else
+    const Skill *const *skills; /**< The skills */
+    size_t count;               /**< Number of skills */
+#endif
 };
\ No newline at end of file
@@ -1,36 +1,51 @@
 #include "slime.h"
+#include "zobrist.h"
 #include <algorithm>
 
-Slime::Slime(const std::string &name, SlimeType type, int maxHP, int attack, int defense, int speed)
-    : name(name), type(type), maxHP(maxHP), currentHP(maxHP), attack(attack), defense(defense), speed(speed)
+/**
+ * @brief Gets the skills every slime of a type knows.
+ * @param type The slime type.
+ * @return A view of the shared skills of the type.
+ */
+static SkillList speciesSkills(SlimeType type)
 {
-    skills.emplace_back("Tackle", SkillType::Normal, 20, 100, 0);
+    static const Skill *const grass[] = {&Skill::get(SkillId::Tackle), &Skill::get(SkillId::Leaf)};
+    static const Skill *const fire[] = {&Skill::get(SkillId::Tackle), &Skill::get(SkillId::Flame)};
+    static const Skill *const water[] = {&Skill::get(SkillId::Tackle), &Skill::get(SkillId::Stream)};
+    static const Skill *const other[] = {&Skill::get(SkillId::Tackle)};
     switch (type)
     {
     case SlimeType::Grass:
-        skills.emplace_back("Leaf", SkillType::Grass, 20, 100, 0);
-        break;
+        return SkillList(grass, 2);
     case SlimeType::Fire:
-        skills.emplace_back("Flame", SkillType::Fire, 20, 100, 0);
-        break;
+        return SkillList(fire, 2);
     case SlimeType::Water:
-        skills.emplace_back("Stream", SkillType::Water, 20, 100, 0);
-        break;
+        return SkillList(water, 2);
+    default:
+        return SkillList(other, 1);
     }
 }
 
-std::string Slime::getName() const { return name; }
+Slime::Slime(std::string_view name, SlimeType type, int maxHP, int attack, int defense, int speed)
+    : name(NameTable::intern(name)), type(type), maxHP(maxHP), currentHP(maxHP), attack(attack), defense(defense),
+      speed(speed), skills(speciesSkills(type))
+{
+}
+
+std::string_view Slime::getName() const { return NameTable::get(name); }
 SlimeType Slime::getType() const { return type; }
 int Slime::getCurrentHP() const { return currentHP; }
 int Slime::getMaxHP() const { return maxHP; }
 int Slime::getAttack() const { return attack; }
 int Slime::getDefense() const { return defense; }
 int Slime::getSpeed() const { return speed; }
-const std::vector<Skill> &Slime::getSkills() const { return skills; }
+const SkillList &Slime::getSkills() const { return skills; }
 
 void Slime::takeDamage(int damage)
 {
+    int oldHP = currentHP;
     currentHP = std::max(0, currentHP - damage);
+    updateHPHash(oldHP);
 }
 
 bool Slime::isDefeated() const
@@ -40,7 +55,16 @@ bool Slime::isDefeated() const
 
 void Slime::heal(int amount)
 {
+    int oldHP = currentHP;
     currentHP = std::min(maxHP, currentHP + amount);
+    updateHPHash(oldHP);
+}
+
+void Slime::restoreHP(int hp)
+{
+    int oldHP = currentHP;
+    currentHP = hp;
+    updateHPHash(oldHP);
 }
 
 void Slime::boostAttack()
@@ -49,6 +73,10 @@ void Slime::boostAttack()
     {
         attackBoosted = true;
         attack = attack * 2;
+        if (hash)
+        {
+            *hash ^= Zobrist::boosted(side, slot);
+        }
     }
 }
 
@@ -58,5 +86,24 @@ void Slime::resetAttackBoost()
     {
         attackBoosted = false;
         attack = attack / 2;
+        if (hash)
+        {
+            *hash ^= Zobrist::boosted(side, slot);
+        }
+    }
+}
+
+void Slime::attachHash(uint64_t *hash, Side side, int slot)
+{
+    this->hash = hash;
+    this->side = side;
+    this->slot = slot;
+}
+
+void Slime::updateHPHash(int oldHP)
+{
+    if (hash)
+    {
+        *hash ^= Zobrist::hp(side, slot, oldHP) ^ Zobrist::hp(side, slot, currentHP);
     }
 }
\ No newline at end of file
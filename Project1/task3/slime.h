@@ -1,7 +1,11 @@
 #pragma once
-#include <string>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
 #include "skill.h"
+#include "side.h"
+#include "team_config.h"
 
 /**
  * @brief Enumeration of possible slime types in the game.
@@ -10,7 +14,8 @@ enum class SlimeType
 {
     Grass, /**< Grass type slime */
     Fire,  /**< Fire type slime */
-    Water  /**< Water type slime */
+    Water, /**< Water type slime */
+    Count  /**< Number of slime types, not a type itself */
 };
 
 /**
@@ -32,13 +37,19 @@ public:
      * @param defense The defense stat of the slime.
      * @param speed The speed stat of the slime.
      */
-    Slime(const std::string &name, SlimeType type, int maxHP, int attack, int defense, int speed);
+    Slime(std::string_view name, SlimeType type, int maxHP, int attack, int defense, int speed);
 
     /**
      * @brief Gets the name of the slime.
-     * @return The name of the slime.
+     * @return The name of the slime, from the NameTable.
      */
-    std::string getName() const;
+    std::string_view getName() const;
+
+    /**
+     * @brief Gets the interned name of the slime.
+     * @return The id of the name in the NameTable.
+     */
+    NameId getNameId() const { return name; }
 
     /**
      * @brief Gets the type of the slime.
@@ -78,9 +89,9 @@ public:
 
     /**
      * @brief Gets the skills of the slime.
-     * @return A const reference to the vector of Skills.
+     * @return The skills of the slime's species, shared by every slime of its type.
      */
-    const std::vector<Skill> &getSkills() const;
+    const SkillList &getSkills() const;
 
     /**
      * @brief Applies damage to the slime.
@@ -100,6 +111,13 @@ public:
      */
     void heal(int amount);
 
+    /**
+     * @brief Sets the current HP back to an earlier value, keeping the Zobrist hash up to date.
+     * @details Used to undo damage and healing, e.g. by Engine::undoTurn.
+     * @param hp The HP to restore.
+     */
+    void restoreHP(int hp);
+
     /**
      * @brief Boosts the attack power of the slime.
      */
@@ -116,14 +134,138 @@ public:
      */
     bool isAttackBoosted() const { return attackBoosted; }
 
+    /**
+     * @brief Makes the slime keep its player's Zobrist hash up to date as its HP and boost change.
+     * @param hash The hash to update, owned by the slime's player.
+     * @param side The side the slime plays on.
+     * @param slot The index of the slime in its team.
+     */
+    void attachHash(uint64_t *hash, Side side, int slot);
+
+    /**
+     * @brief Gets the index of the slime in its team, as given to attachHash.
+     * @return The index of the slime in its team.
+     */
+    int getSlot() const { return slot; }
+
 private:
-    std::string name;           /**< The name of the slime */
+    NameId name;                /**< The interned name of the slime */
     SlimeType type;             /**< The type of the slime */
     int maxHP;                  /**< The maximum hit points of the slime */
     int currentHP;              /**< The current hit points of the slime */
     int attack;                 /**< The attack stat of the slime */
     int defense;                /**< The defense stat of the slime */
     int speed;                  /**< The speed stat of the slime */
-    std::vector<Skill> skills;  /**< The skills possessed by the slime */
+    SkillList skills;           /**< The skills of the slime's species */
     bool attackBoosted = false; /**< Flag indicating if the slime's attack is currently boosted */
-};
\ No newline at end of file
+    uint64_t *hash = nullptr;   /**< Zobrist hash of the owning player, nullptr until attached */
+    Side side = Side::Player;   /**< The side the slime plays on, selects its Zobrist keys */
+    int slot = 0;               /**< The index of the slime in its team, selects its Zobrist keys */
+
+    /**
+     * @brief Moves the attached hash from one HP value to another.
+     * @param oldHP The HP before the change.
+     */
+    void updateHPHash(int oldHP);
+};
+
+/**
+ * @class SlimeList
+ * @brief A view of a team's slimes, which its player stores contiguously by value.
+ *
+ * Slimes are identified by their index in the list, which is also their slot in BattleState.
+ * With a fixed team size a complete team has a compile-time constant size, so loops over the team
+ * can be unrolled; a team still being built or cleared is viewed as empty.
+ */
+class SlimeList
+{
+public:
+    /**
+     * @brief Constructs a view of a team.
+     * @param slimes The first slime, the array must outlive the view.
+     * @param count Number of slimes in the team; with a fixed team size only a complete team is viewed.
+     */
+#if SLIME_TEAM_SIZE > 0
+    SlimeList(Slime *slimes, size_t count) : slimes(count == kFixedTeamSize ? slimes : nullptr) {}
+#else
+    SlimeList(Slime *slimes, size_t count) : slimes(slimes), count(count) {}
+#endif
+
+    /**
+     * @brief Gets the number of slimes.
+     * @return The number of slimes in the team.
+     */
+#if SLIME_TEAM_SIZE > 0
+    size_t size() const { return slimes ? kFixedTeamSize : 0; }
+#else
+    size_t size() const { return count; }
+#endif
+
+    /**
+     * @brief Gets a slime of the team.
+     * @param index The index of the slime, less than size().
+     * @return The slime.
+     */
+    Slime &operator[](size_t index) const { return slimes[index]; }
+
+    Slime *begin() const { return slimes; }        /**< First slime, for range-based for loops */
+    Slime *end() const { return slimes + size(); } /**< Past the last slime, for range-based for loops */
+
+private:
+    Slime *slimes; /**< The slimes, nullptr for an incomplete team when the team size is fixed */
+#if SLIME_TEAM_SIZE == 0
+    size_t count; /**< Number of slimes */
+#endif
+};
+
+/**
+ * @brief Unrolled findSlot of a fixed-size team, see findSlot.
+ */
+template <typename Predicate, size_t... Slots>
+inline int findSlotUnrolled(Predicate &predicate, std::index_sequence<Slots...>)
+{
+    int found = -1;
+    // || stops at the first slot that matches, like the loop of a dynamic team
+    (void)((predicate(static_cast<int>(Slots)) && (found = static_cast<int>(Slots), true)) || ...);
+    return found;
+}
+
+/**
+ * @brief Finds the first slot of a team that matches a predicate.
+ * @details With a fixed team size the slots are tested in a fully unrolled sequence, otherwise in a loop.
+ * @param slimes The team.
+ * @param predicate Called with slot indices in increasing order until it returns true.
+ * @return The first matching slot, or -1 if none matches.
+ */
+template <typename Predicate>
+inline int findSlot(const SlimeList &slimes, Predicate predicate)
+{
+#if SLIME_TEAM_SIZE > 0
+    if (slimes.size() == 0)
+    {
+        return -1;
+    }
+    return findSlotUnrolled(predicate, std::make_index_sequence<kFixedTeamSize>());
+#else
+    for (size_t i = 0; i < slimes.size(); ++i)
+    {
+        if (predicate(static_cast<int>(i)))
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+#endif
+}
+
+/**
+ * @brief Calls a function with every slot of a team in increasing order, unrolled as in findSlot.
+ * @param slimes The team.
+ * @param function Called with each slot index.
+ */
+template <typename Function>
+inline void forEachSlot(const SlimeList &slimes, Function function)
+{
+    findSlot(slimes, [&](int slot)
+             { function(slot); return false; });
+}
\ No newline at end of file
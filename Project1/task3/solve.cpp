@@ -0,0 +1,80 @@
+#include "solver.h"
+#include "player.h"
+#include "roster.h"
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+int main(int argc, char *argv[])
+{
+    if (argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " [round-limit] [tablebase-file]" << std::endl;
+        std::cerr << "The state count grows about a hundredfold every two rounds, limits above 7 run out of memory." << std::endl;
+        return 1;
+    }
+    // the full 100-round game is far too large to solve, see GameSolver
+    int roundLimit = argc > 1 ? std::atoi(argv[1]) : 5;
+    std::string path = argc > 2 ? argv[2] : "tablebase.bin";
+
+    // the task 3 setup of main.cpp: both sides have the standard team, only the enemy has potions
+    BattleArena arena;
+    Player player(nullptr, arena);
+    Player enemy(nullptr, arena);
+    addStandardSlimes(player);
+    addStandardSlimes(enemy);
+    addStandardPotions(enemy);
+    BattleSetup setup = BattleSetup::fromPlayers(player, enemy);
+
+    BattleState initial = {};
+    const Player *players[2] = {&player, &enemy};
+    for (int s = 0; s < 2; ++s)
+    {
+        for (size_t i = 0; i < players[s]->getSlimes().size(); ++i)
+        {
+            initial.sides[s].hp[i] = static_cast<int16_t>(players[s]->getSlimes()[i].getMaxHP());
+        }
+        for (const Potion &potion : players[s]->getPotions())
+        {
+            if (potion.getType() == Potion::Type::Revival)
+            {
+                initial.sides[s].revivalPotions++;
+            }
+            else
+            {
+                initial.sides[s].attackPotions++;
+            }
+        }
+    }
+    initial.round = 1;
+
+    GameSolver solver(setup, roundLimit);
+    auto start = std::chrono::steady_clock::now();
+    double value;
+    int bestStart;
+    try
+    {
+        value = solver.solveStart(initial, bestStart);
+    }
+    catch (const std::length_error &error)
+    {
+        std::cerr << "Solver stopped after " << solver.getStateCount() << " states: " << error.what() << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Round limit: " << roundLimit << std::endl;
+    std::cout << "Solved states: " << solver.getStateCount() << " in " << seconds << " s" << std::endl;
+    std::cout << "Game value for the player: " << value << std::endl;
+    std::cout << "Best starting slime: " << player.getSlimes()[bestStart].getName() << std::endl;
+
+    if (!solver.writeTablebase(path))
+    {
+        std::cerr << "Could not write " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Tablebase written to " << path << std::endl;
+    return 0;
+}
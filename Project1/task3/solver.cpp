@@ -0,0 +1,189 @@
+#include "solver.h"
+#include "matrix_game.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+static const char kTablebaseMagic[8] = {'S', 'L', 'I', 'M', 'E', 'T', 'B', '3'};
+
+/**
+ * @brief Writes a 32-bit integer of a tablebase header.
+ * @param out The tablebase file.
+ * @param value The value to write.
+ */
+static void writeHeaderInt(std::ofstream &out, int value)
+{
+    int32_t field = static_cast<int32_t>(value);
+    out.write(reinterpret_cast<const char *>(&field), sizeof(field));
+}
+
+GameSolver::GameSolver(const BattleSetup &setup, int roundLimit, size_t maxStates)
+    : setup(setup), roundLimit(roundLimit), maxStates(maxStates)
+{
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        if (setup.getTeamSize(side) > kStandardTeamSize)
+        {
+            throw std::invalid_argument("teams must not be larger than the standard team");
+        }
+        for (int i = 0; i < setup.getTeamSize(side); ++i)
+        {
+            if (static_cast<uint64_t>(setup.getSpecies(side, i).maxHP) >= hpRadix(i))
+            {
+                throw std::invalid_argument("slime HP exceeds the bounds of StateIndexer");
+            }
+        }
+    }
+    if (static_cast<uint64_t>(roundLimit) >= StateIndexer::kRoundCount)
+    {
+        throw std::invalid_argument("round limit exceeds the bounds of StateIndexer");
+    }
+}
+
+bool GameSolver::isGameOver(const BattleState &state) const
+{
+    return Engine::isDefeated(state, Side::Player) || Engine::isDefeated(state, Side::Enemy) || state.round >= roundLimit;
+}
+
+double GameSolver::solve(const BattleState &state)
+{
+    uint64_t key = StateIndexer::rankWithRound(state);
+    auto it = values.find(key);
+    if (it != values.end())
+    {
+        return it->second;
+    }
+
+    Action playerActions[kMaxActions];
+    Action enemyActions[kMaxActions];
+    int rows = Engine::listActions(state, setup, Side::Player, playerActions);
+    int cols = Engine::listActions(state, setup, Side::Enemy, enemyActions);
+
+    MatrixGame game(rows, cols);
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < cols; ++j)
+        {
+            // misses and critical hits make the entry the expected value over the turn's outcomes
+            TurnOutcome outcomes[kMaxOutcomes];
+            double probabilities[kMaxOutcomes];
+            int count = Engine::listOutcomes(state, setup, playerActions[i], enemyActions[j], outcomes, probabilities);
+            double value = 0.0;
+            for (int k = 0; k < count; ++k)
+            {
+                BattleState next = state;
+                Engine::executeTurn(next, setup, playerActions[i], enemyActions[j], outcomes[k]);
+                value += probabilities[k] * valueAfterTurn(next);
+            }
+            game.set(i, j, value);
+        }
+    }
+    double value = game.solve();
+
+    if (values.size() >= maxStates)
+    {
+        throw std::length_error("state limit reached, try a lower round limit");
+    }
+    values.emplace(key, static_cast<float>(value));
+    return value;
+}
+
+double GameSolver::valueAfterTurn(const BattleState &state)
+{
+    if (Engine::isDefeated(state, Side::Player))
+    {
+        return -1.0;
+    }
+    if (Engine::isDefeated(state, Side::Enemy))
+    {
+        return 1.0;
+    }
+    if (state.round >= roundLimit)
+    {
+        return 0.0;
+    }
+
+    BattleState next = state;
+    next.round++;
+
+    // at most one slime is beaten per turn, since the turn stops as soon as it happens
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        const SideState &own = state[side];
+        if (own.hp[own.active] > 0)
+        {
+            continue;
+        }
+        // the player picks the replacement that is best for them, the enemy the one that is worst for the player
+        double best = side == Side::Player ? -2.0 : 2.0;
+        for (int i = 0; i < setup.getTeamSize(side); ++i)
+        {
+            if (own.hp[i] > 0)
+            {
+                BattleState replaced = next;
+                Engine::sendSlime(replaced, side, i);
+                double value = solve(replaced);
+                best = side == Side::Player ? std::max(best, value) : std::min(best, value);
+            }
+        }
+        return best;
+    }
+    return solve(next);
+}
+
+double GameSolver::solveStart(const BattleState &initial, int &bestStart)
+{
+    double best = -2.0;
+    bestStart = 0;
+    for (int i = 0; i < setup.getTeamSize(Side::Player); ++i)
+    {
+        double worst = 2.0;
+        for (int j = 0; j < setup.getTeamSize(Side::Enemy); ++j)
+        {
+            BattleState state = initial;
+            state[Side::Player].active = static_cast<int8_t>(i);
+            state[Side::Enemy].active = static_cast<int8_t>(j);
+            worst = std::min(worst, solve(state));
+        }
+        if (worst > best)
+        {
+            best = worst;
+            bestStart = i;
+        }
+    }
+    return best;
+}
+
+bool GameSolver::writeTablebase(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        return false;
+    }
+    uint64_t count = values.size();
+    out.write(kTablebaseMagic, sizeof(kTablebaseMagic));
+    // the battle the values belong to, a table solved to another round limit or for other teams is a different game
+    writeHeaderInt(out, roundLimit);
+    writeHeaderInt(out, setup.getCriticalChance());
+    for (Side side : {Side::Player, Side::Enemy})
+    {
+        writeHeaderInt(out, setup.getTeamSize(side));
+        for (int i = 0; i < setup.getTeamSize(side); ++i)
+        {
+            const SpeciesData &species = setup.getSpecies(side, i);
+            writeHeaderInt(out, static_cast<int>(species.type));
+            writeHeaderInt(out, species.maxHP);
+            writeHeaderInt(out, species.attack);
+            writeHeaderInt(out, species.defense);
+            writeHeaderInt(out, species.speed);
+        }
+    }
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const auto &entry : values)
+    {
+        out.write(reinterpret_cast<const char *>(&entry.first), sizeof(uint64_t));
+        out.write(reinterpret_cast<const char *>(&entry.second), sizeof(float));
+    }
+    return static_cast<bool>(out);
+}
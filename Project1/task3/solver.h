@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "battle_state.h"
+#include "engine.h"
+#include "state_index.h"
+
+/**
+ * @class GameSolver
+ * @brief Computes the exact value of the battle by retrograde analysis.
+ *
+ * Every turn both sides choose their actions simultaneously, so the battle is a finite
+ * simultaneous-move game. The solver walks every state reachable from the given one,
+ * values finished games (+1 player win, -1 enemy win, 0 draw) and, going back up, solves
+ * the payoff matrix of each turn for its mixed equilibrium. Forced replacements are
+ * single-player choices of the side whose slime was beaten. Values are memoized per state
+ * (keyed by their StateIndexer rank), so states reached by different move orders are solved once.
+ *
+ * The number of reachable states grows about a hundredfold every two rounds (about 20 million
+ * states for a round limit of 7), so the full 100-round game is far out of reach. The round
+ * limit is therefore a parameter: the result is the exact value of the game played to that limit.
+ * For the same reason no strategy plays from the tablebase: its values are those of the shortened
+ * game, not of the games the engine plays to kRoundLimit.
+ */
+class GameSolver
+{
+public:
+    /**
+     * @brief Constructs a new GameSolver.
+     * @param setup The static data of the battle.
+     * @param roundLimit The round at which the game is a draw, lower limits keep the state count small.
+     * @param maxStates The solver gives up (throws std::length_error) once it has stored this many states.
+     * @throws std::invalid_argument if the teams are larger than the standard team StateIndexer is built for.
+     */
+    GameSolver(const BattleSetup &setup, int roundLimit = kRoundLimit, size_t maxStates = 20000000);
+
+    /**
+     * @brief Solves the game from a start-of-turn state.
+     * @param state A state where both active slimes are standing.
+     * @return The value of the state for the player, between -1 and 1.
+     */
+    double solve(const BattleState &state);
+
+    /**
+     * @brief Solves the game including the choice of the starting slimes.
+     * @details As in Engine::startGame, the player chooses first and the enemy answers knowing that choice.
+     * @param initial The initial state, its active slimes are ignored.
+     * @param bestStart Receives the index of the player's best starting slime.
+     * @return The value of the game for the player.
+     */
+    double solveStart(const BattleState &initial, int &bestStart);
+
+    /**
+     * @brief Gets the number of solved states.
+     * @return The number of states in the table.
+     */
+    size_t getStateCount() const { return values.size(); }
+
+    /**
+     * @brief Writes every solved state and its value to a tablebase file.
+     * @details The values are only exact for the battle that was solved, so the header describes it: the
+     * magic "SLIMETB3", then as 32-bit integers the round limit, the critical chance and, for the player
+     * and then the enemy, the team size followed by the type, max HP, attack, defense and speed of each
+     * slime. Then come the number of states as a 64-bit integer and one StateIndexer::rankWithRound key
+     * with its float value per state. A reader must reject a file whose header differs from its own battle.
+     * @param path The file to write.
+     * @return true if the file was written, false otherwise.
+     */
+    bool writeTablebase(const std::string &path) const;
+
+private:
+    BattleSetup setup; /**< The static data of the battle */
+    int roundLimit;    /**< The round at which the game is a draw */
+    size_t maxStates;  /**< Most states the solver may store */
+    std::unordered_map<uint64_t, float> values; /**< Value of every solved state, keyed by StateIndexer::rankWithRound */
+
+    /**
+     * @brief Values the state reached at the end of a turn.
+     * @details Handles finished games, forced replacements and the move to the next round.
+     * @param state The state right after Engine::executeTurn.
+     * @return The value of the state for the player.
+     */
+    double valueAfterTurn(const BattleState &state);
+
+    /**
+     * @brief Checks if the game is over, using the solver's round limit.
+     * @param state The state to check.
+     * @return true if the game is over, false otherwise.
+     */
+    bool isGameOver(const BattleState &state) const;
+};
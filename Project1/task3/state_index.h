@@ -0,0 +1,160 @@
+#pragma once
+#include <cstdint>
+#include "battle_state.h"
+#include "roster.h"
+#include "engine.h"
+
+static_assert(kStandardTeamSize <= kMaxTeamSize, "the standard team must fit in a BattleState");
+
+/**
+ * @brief Gets the radix of the HP digit of a slime.
+ * @param index The index of the slime in the standard team.
+ * @return The number of HP values the slime can have.
+ */
+constexpr uint64_t hpRadix(int index) { return kStandardRoster[index].maxHP + 1; }
+
+/**
+ * @brief Computes the number of states of one side.
+ * @return The product of every radix of a side.
+ */
+constexpr uint64_t sideStateCount()
+{
+    uint64_t count = 1;
+    for (int i = 0; i < kStandardTeamSize; ++i)
+    {
+        count *= hpRadix(i);
+    }
+    return count * kStandardTeamSize * 2 * (kStandardRevivalPotions + 1) * (kStandardAttackPotions + 1);
+}
+
+/**
+ * @class StateIndexer
+ * @brief Perfect, dense indexing of battle states for flat tables.
+ *
+ * Every field of a side (the HP of each slime, the active slime, the boost flag and the
+ * unused potions) is a digit of a mixed-radix number whose radices are derived at compile
+ * time from the standard roster in roster.h. rank() and unrank() are a bijection between
+ * the states within those bounds and [0, kStateCount), so tables can be flat arrays indexed
+ * by rank instead of hash maps. The round is not part of the rank, tables that need it
+ * index by rankWithRound().
+ */
+class StateIndexer
+{
+public:
+    static constexpr uint64_t kSideStateCount = sideStateCount();               /**< Number of states of one side */
+    static constexpr uint64_t kStateCount = kSideStateCount * kSideStateCount; /**< Number of states of a battle, without the round */
+    static constexpr uint64_t kRoundCount = kRoundLimit + 1;                   /**< Number of values the round can take */
+
+    static_assert(kStateCount <= UINT64_MAX / kRoundCount, "ranks with the round must fit in 64 bits");
+
+    /**
+     * @brief Ranks a battle state, ignoring its round.
+     * @param state A state within the standard roster's bounds.
+     * @return The dense index of the state, in [0, kStateCount).
+     */
+    static uint64_t rank(const BattleState &state)
+    {
+        return rankSide(state.sides[0]) * kSideStateCount + rankSide(state.sides[1]);
+    }
+
+    /**
+     * @brief Ranks a battle state together with its round.
+     * @param state A state within the standard roster's bounds.
+     * @return The dense index of the state, in [0, kStateCount * kRoundCount).
+     */
+    static uint64_t rankWithRound(const BattleState &state)
+    {
+        return rank(state) * kRoundCount + state.round;
+    }
+
+    /**
+     * @brief Rebuilds the battle state of a rank.
+     * @param index A rank returned by rank().
+     * @param round The round to give the state.
+     * @return The state with that rank.
+     */
+    static BattleState unrank(uint64_t index, int round = 0)
+    {
+        BattleState state = {};
+        state.sides[1] = unrankSide(index % kSideStateCount);
+        state.sides[0] = unrankSide(index / kSideStateCount);
+        state.round = static_cast<int16_t>(round);
+        return state;
+    }
+
+    /**
+     * @brief Rebuilds the battle state of a rank including the round.
+     * @param index A rank returned by rankWithRound().
+     * @return The state with that rank.
+     */
+    static BattleState unrankWithRound(uint64_t index)
+    {
+        return unrank(index / kRoundCount, static_cast<int>(index % kRoundCount));
+    }
+
+    /**
+     * @brief Checks if a battle state is within the bounds of the index.
+     * @param state The state to check.
+     * @return true if the state can be ranked, false otherwise.
+     */
+    static bool isInBounds(const BattleState &state)
+    {
+        for (const SideState &side : state.sides)
+        {
+            for (int i = 0; i < kMaxTeamSize; ++i)
+            {
+                uint64_t limit = i < kStandardTeamSize ? hpRadix(i) : 1;
+                if (side.hp[i] < 0 || static_cast<uint64_t>(side.hp[i]) >= limit)
+                {
+                    return false;
+                }
+            }
+            if (side.active < 0 || side.active >= kStandardTeamSize || side.revivalPotions < 0 || side.revivalPotions > kStandardRevivalPotions ||
+                side.attackPotions < 0 || side.attackPotions > kStandardAttackPotions)
+            {
+                return false;
+            }
+        }
+        return state.round >= 0 && static_cast<uint64_t>(state.round) < kRoundCount;
+    }
+
+private:
+    /**
+     * @brief Ranks one side as a multiply-add chain over its digits.
+     */
+    static uint64_t rankSide(const SideState &side)
+    {
+        uint64_t index = 0;
+        for (int i = 0; i < kStandardTeamSize; ++i)
+        {
+            index = index * hpRadix(i) + side.hp[i];
+        }
+        index = index * kStandardTeamSize + side.active;
+        index = index * 2 + (side.boosted ? 1 : 0);
+        index = index * (kStandardRevivalPotions + 1) + side.revivalPotions;
+        index = index * (kStandardAttackPotions + 1) + side.attackPotions;
+        return index;
+    }
+
+    /**
+     * @brief Rebuilds one side from its rank, peeling the digits off in reverse order.
+     */
+    static SideState unrankSide(uint64_t index)
+    {
+        SideState side = {};
+        side.attackPotions = static_cast<int8_t>(index % (kStandardAttackPotions + 1));
+        index /= kStandardAttackPotions + 1;
+        side.revivalPotions = static_cast<int8_t>(index % (kStandardRevivalPotions + 1));
+        index /= kStandardRevivalPotions + 1;
+        side.boosted = index % 2 == 1;
+        index /= 2;
+        side.active = static_cast<int8_t>(index % kStandardTeamSize);
+        index /= kStandardTeamSize;
+        for (int i = kStandardTeamSize - 1; i >= 0; --i)
+        {
+            side.hp[i] = static_cast<int16_t>(index % hpRadix(i));
+            index /= hpRadix(i);
+        }
+        return side;
+    }
+};
@@ -1,29 +1,57 @@
 #include "strategy.h"
 #include "engine.h"
 #include "slime.h"
+#include "matrix_game.h"
+#include "zobrist.h"
+#include "type_chart.h"
+#include "rng.h"
 #include <iostream>
 #include <vector>
-#include <random>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
 
-int HumanStrategy::chooseNextSlimeIndex(const std::vector<Slime *> &slimes, Slime *activeSlime)
+void Strategy::setSide(Side side) { this->side = side; }
+void Strategy::setRng(Rng &rng) { this->rng = &rng; }
+
+const Player &Strategy::getOwnPlayer(const Engine &engine) const
+{
+    return side == Side::Player ? engine.getPlayer() : engine.getEnemy();
+}
+
+const Player &Strategy::getOpponent(const Engine &engine) const
+{
+    return side == Side::Player ? engine.getEnemy() : engine.getPlayer();
+}
+
+Slime *Strategy::getOwnActiveSlime(const Engine &engine) const
+{
+    return side == Side::Player ? engine.getPlayerActiveSlime() : engine.getEnemyActiveSlime();
+}
+
+Slime *Strategy::getOpponentActiveSlime(const Engine &engine) const
+{
+    return side == Side::Player ? engine.getEnemyActiveSlime() : engine.getPlayerActiveSlime();
+}
+
+int HumanStrategy::chooseNextSlimeIndex(const SlimeList &slimes, Slime *activeSlime)
 {
     std::vector<int> validChoices;
 
     // find all valid choices
-    for (size_t i = 0; i < slimes.size(); ++i)
-    {
-        if (!slimes[i]->isDefeated() && slimes[i] != activeSlime)
+    forEachSlot(slimes, [&](int i)
+                {
+        if (!slimes[i].isDefeated() && &slimes[i] != activeSlime)
         {
             validChoices.push_back(i);
-        }
-    }
+        } });
 
     while (true)
     {
         std::cout << "Select your next slime (";
         for (size_t i = 0; i < validChoices.size(); ++i)
         {
-            std::cout << validChoices[i] + 1 << " for " << slimes[validChoices[i]]->getName();
+            std::cout << validChoices[i] + 1 << " for " << slimes[validChoices[i]].getName();
             if (i < validChoices.size() - 1)
             {
                 std::cout << ", ";
@@ -46,14 +74,14 @@ int HumanStrategy::chooseNextSlimeIndex(const std::vector<Slime *> &slimes, Slim
 
 Action HumanStrategy::chooseAction(const Engine &engine)
 {
-    const std::vector<Slime *> &slimes = engine.getPlayer().getSlimes();
-    Slime *activeSlime = engine.getPlayerActiveSlime();
+    SlimeList slimes = getOwnPlayer(engine).getSlimes();
+    Slime *activeSlime = getOwnActiveSlime(engine);
     bool hasAliveInactiveSlimes = false;
 
     // check if player has any other slime that is not defeated
-    for (const auto &slime : slimes)
+    for (const Slime &slime : slimes)
     {
-        if (!slime->isDefeated() && slime != activeSlime)
+        if (!slime.isDefeated() && &slime != activeSlime)
         {
             hasAliveInactiveSlimes = true;
             break;
@@ -87,7 +115,7 @@ Action HumanStrategy::chooseAction(const Engine &engine)
         while (skillIndex < 1 || skillIndex > 2)
         {
             std::cout << "Select the skill (1 for Tackle, 2 for "
-                      << engine.getPlayerActiveSlime()->getSkills()[1].getName() << "): ";
+                      << activeSlime->getSkills()[1].getName() << "): ";
             std::cin >> skillIndex;
         }
         skillIndex = skillIndex - 1; // skillIndex is 0-based
@@ -101,7 +129,7 @@ Action HumanStrategy::chooseAction(const Engine &engine)
     }
 }
 
-Slime *HumanStrategy::chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine)
+int HumanStrategy::chooseStartingSlime(const SlimeList &, const Engine &)
 {
     int choice = 0;
     // if user's input is not in range, ask again until it is
@@ -110,14 +138,13 @@ Slime *HumanStrategy::chooseStartingSlime(const std::vector<Slime *> &slimes, co
         std::cout << "Select your starting slime (1 for Green, 2 for Red, 3 for Blue): ";
         std::cin >> choice;
     }
-    return slimes[choice - 1]; // index is 0-based
+    return choice - 1; // index is 0-based
 }
 
-Slime *HumanStrategy::chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine)
+int HumanStrategy::chooseNextSlime(const SlimeList &slimes, const Engine &engine)
 {
-    Slime *activeSlime = engine.getPlayerActiveSlime();
-    int slimeIndex = chooseNextSlimeIndex(slimes, activeSlime);
-    return slimes[slimeIndex];
+    Slime *activeSlime = getOwnActiveSlime(engine);
+    return chooseNextSlimeIndex(slimes, activeSlime);
 }
 
 Action SimpleAIStrategy::chooseAction(const Engine &engine)
@@ -125,11 +152,9 @@ Action SimpleAIStrategy::chooseAction(const Engine &engine)
     // simple ai controlled enemy won't change slime during battle unless their current one dies and is forced to choose a new slime
     // if enemy's current slime has type advantage(effectiveness) over player's current slime, use the second skill
     // else, always use the first skill
-    const Slime *slime = engine.getEnemyActiveSlime(); // enemy's slime
-    const Slime *playerCurrentSlime = engine.getPlayerActiveSlime();
-    if ((slime->getType() == SlimeType::Water && playerCurrentSlime->getType() == SlimeType::Fire) ||
-        (slime->getType() == SlimeType::Fire && playerCurrentSlime->getType() == SlimeType::Grass) ||
-        (slime->getType() == SlimeType::Grass && playerCurrentSlime->getType() == SlimeType::Water))
+    const Slime *slime = getOwnActiveSlime(engine); // enemy's slime
+    const Slime *playerCurrentSlime = getOpponentActiveSlime(engine);
+    if (TypeChart::isEffectiveAgainst(slime->getType(), playerCurrentSlime->getType()))
     {
         return Action(ActionType::UseSkill, 1, 0); // skill 2, 0-based
     }
@@ -139,44 +164,48 @@ Action SimpleAIStrategy::chooseAction(const Engine &engine)
     }
 }
 
-Slime *SimpleAIStrategy::chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine)
+int SimpleAIStrategy::chooseStartingSlime(const SlimeList &slimes, const Engine &engine)
 {
     // Simple AI chooses a slime that has type advantage over the player's starting slime
-    Slime *playerSlime = engine.getPlayerActiveSlime();
-    for (Slime *slime : slimes)
+    Slime *playerSlime = getOpponentActiveSlime(engine);
+    // the opponent's starting slime is unknown when this strategy picks first, as on the player's side of a bot-vs-bot game
+    if (playerSlime)
     {
-        if ((slime->getType() == SlimeType::Water && playerSlime->getType() == SlimeType::Fire) ||
-            (slime->getType() == SlimeType::Fire && playerSlime->getType() == SlimeType::Grass) ||
-            (slime->getType() == SlimeType::Grass && playerSlime->getType() == SlimeType::Water))
+        for (size_t i = 0; i < slimes.size(); ++i)
         {
-            return slime;
+            if (TypeChart::isEffectiveAgainst(slimes[i].getType(), playerSlime->getType()))
+            {
+                return static_cast<int>(i);
+            }
         }
     }
     // If no strong matchup, choose randomly
     // NOTE: in real case, this would not happen, enemy will always have one slime that has type advantage over player's starting slime
-    return slimes[rand() % slimes.size()];
+    return static_cast<int>(rng->uniformInt(static_cast<uint32_t>(slimes.size())));
 }
 
-Slime *SimpleAIStrategy::chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine)
+int SimpleAIStrategy::chooseNextSlime(const SlimeList &slimes, const Engine &engine)
 {
-    const Slime *playerCurrentSlime = engine.getPlayerActiveSlime();
+    const Slime *playerCurrentSlime = getOpponentActiveSlime(engine);
 
-    Slime *enemyRedSlime = nullptr;
-    Slime *enemyBlueSlime = nullptr;
-    Slime *enemyGreenSlime = nullptr;
+    int enemyRedSlime = -1;
+    int enemyBlueSlime = -1;
+    int enemyGreenSlime = -1;
 
-    for (Slime *slime : slimes)
+    for (size_t i = 0; i < slimes.size(); ++i)
     {
-        switch (slime->getType())
+        switch (slimes[i].getType())
         {
         case SlimeType::Fire:
-            enemyRedSlime = slime;
+            enemyRedSlime = static_cast<int>(i);
             break;
         case SlimeType::Water:
-            enemyBlueSlime = slime;
+            enemyBlueSlime = static_cast<int>(i);
             break;
         case SlimeType::Grass:
-            enemyGreenSlime = slime;
+            enemyGreenSlime = static_cast<int>(i);
+            break;
+        default:
             break;
         }
     }
@@ -184,11 +213,11 @@ Slime *SimpleAIStrategy::chooseNextSlime(const std::vector<Slime *> &slimes, con
     // choose the one that has type advantage, if not, choose the one that is the same with player's current slime
     if (playerCurrentSlime->getType() == SlimeType::Water)
     {
-        if (enemyGreenSlime && !enemyGreenSlime->isDefeated())
+        if (enemyGreenSlime >= 0 && !slimes[enemyGreenSlime].isDefeated())
         {
             return enemyGreenSlime;
         }
-        else if (enemyBlueSlime && !enemyBlueSlime->isDefeated())
+        else if (enemyBlueSlime >= 0 && !slimes[enemyBlueSlime].isDefeated())
         {
             return enemyBlueSlime;
         }
@@ -196,11 +225,11 @@ Slime *SimpleAIStrategy::chooseNextSlime(const std::vector<Slime *> &slimes, con
 
     else if (playerCurrentSlime->getType() == SlimeType::Fire)
     {
-        if (enemyBlueSlime && !enemyBlueSlime->isDefeated())
+        if (enemyBlueSlime >= 0 && !slimes[enemyBlueSlime].isDefeated())
         {
             return enemyBlueSlime;
         }
-        else if (enemyRedSlime && !enemyRedSlime->isDefeated())
+        else if (enemyRedSlime >= 0 && !slimes[enemyRedSlime].isDefeated())
         {
             return enemyRedSlime;
         }
@@ -208,173 +237,908 @@ Slime *SimpleAIStrategy::chooseNextSlime(const std::vector<Slime *> &slimes, con
 
     else if (playerCurrentSlime->getType() == SlimeType::Grass)
     {
-        if (enemyRedSlime && !enemyRedSlime->isDefeated())
+        if (enemyRedSlime >= 0 && !slimes[enemyRedSlime].isDefeated())
         {
             return enemyRedSlime;
         }
-        else if (enemyGreenSlime && !enemyGreenSlime->isDefeated())
+        else if (enemyGreenSlime >= 0 && !slimes[enemyGreenSlime].isDefeated())
         {
             return enemyGreenSlime;
         }
     }
 
     // iterate and find the last one slime which is not defeated.
-    for (Slime *slime : slimes)
+    for (size_t i = 0; i < slimes.size(); ++i)
     {
-        if (!slime->isDefeated())
+        if (!slimes[i].isDefeated())
         {
-            return slime;
+            return static_cast<int>(i);
         }
     }
+    return -1;
 }
 
-bool GreedyAIStrategy::isEffectiveAgainst(SlimeType attackerType, SlimeType defenderType) const
+/**
+ * @brief A player's team as seen by the greedy rules.
+ */
+struct PlayerTeamView
 {
-    return (attackerType == SlimeType::Water && defenderType == SlimeType::Fire) ||
-           (attackerType == SlimeType::Fire && defenderType == SlimeType::Grass) ||
-           (attackerType == SlimeType::Grass && defenderType == SlimeType::Water);
-}
+    const SlimeList &slimes;        /**< The team */
+    const Player *player = nullptr; /**< The team's player, only read for its potions by the potion-greedy rules */
+
+    SlimeType getType(int slot) const { return slimes[slot].getType(); }
+    bool isStanding(int slot) const { return !slimes[slot].isDefeated(); }
+    bool isBoosted(int slot) const { return slimes[slot].isAttackBoosted(); }
+    bool hasRevivalPotion() const { return player->canUseRevivalPotion(); }
+    bool hasAttackPotion() const { return player->canUseAttackPotion(); }
 
-Slime *GreedyAIStrategy::findEffectiveSlime(const std::vector<Slime *> &slimes, const Slime *targetSlime) const
+    template <typename Predicate>
+    int find(Predicate predicate) const { return findSlot(slimes, predicate); }
+};
+
+/**
+ * @brief One side of a battle state as seen by the greedy rules.
+ */
+struct StateTeamView
 {
-    for (Slime *slime : slimes)
+    const BattleState &state; /**< The position */
+    const BattleSetup &setup; /**< The static data of the battle */
+    Side side;                /**< The side whose team this is */
+
+    SlimeType getType(int slot) const { return setup.getSpecies(side, slot).type; }
+    bool isStanding(int slot) const { return state[side].hp[slot] > 0; }
+    bool isBoosted(int slot) const { return slot == state[side].active && state[side].boosted; }
+    bool hasRevivalPotion() const { return state[side].revivalPotions > 0; }
+    bool hasAttackPotion() const { return state[side].attackPotions > 0; }
+
+    template <typename Predicate>
+    int find(Predicate predicate) const
     {
-        if (!slime->isDefeated() && isEffectiveAgainst(slime->getType(), targetSlime->getType()))
+        for (int i = 0; i < setup.getTeamSize(side); ++i)
         {
-            return slime;
+            if (predicate(i))
+            {
+                return i;
+            }
         }
+        return -1;
     }
-    return nullptr;
+};
+
+// the greedy rules are written once over a team view, so the greedy strategies and the MCTS rollouts always agree
+
+/**
+ * @brief Chooses a skill by the simple rules: the second skill against a slime the active one is effective against, else the first.
+ * @param activeType The type of the choosing side's active slime.
+ * @param opponentType The type of the opponent's active slime.
+ * @return The chosen action.
+ */
+static Action chooseSimpleSkill(SlimeType activeType, SlimeType opponentType)
+{
+    return Action(ActionType::UseSkill, TypeChart::isEffectiveAgainst(activeType, opponentType) ? 1 : 0, 0);
 }
 
-Action GreedyAIStrategy::chooseAction(const Engine &engine)
+/**
+ * @brief Finds the first standing slime of a team with a type advantage over a slime type.
+ * @return The slot of the slime, or -1 if there is none.
+ */
+template <typename Team>
+static int findEffectiveSlot(const Team &team, SlimeType target)
 {
-    const Slime *playerSlime = engine.getPlayerActiveSlime();
-    const Slime *enemySlime = engine.getEnemyActiveSlime();
-    const std::vector<Slime *> &enemySlimes = engine.getEnemy().getSlimes();
+    return team.find([&](int i)
+                     { return team.isStanding(i) && TypeChart::isEffectiveAgainst(team.getType(i), target); });
+}
 
+/**
+ * @brief Chooses an action by the greedy rules.
+ * @param team The choosing side's team.
+ * @param active The slot of its active slime.
+ * @param opponentType The type of the opponent's active slime.
+ * @return The chosen action.
+ */
+template <typename Team>
+static Action chooseGreedyAction(const Team &team, int active, SlimeType opponentType)
+{
     // Check if there's a more effective slime to switch to
-    Slime *effectiveSlime = findEffectiveSlime(enemySlimes, playerSlime);
-    if (effectiveSlime && effectiveSlime != enemySlime)
+    int effectiveSlime = findEffectiveSlot(team, opponentType);
+    if (effectiveSlime >= 0 && effectiveSlime != active)
     {
-        return Action(ActionType::ChangeSlime, std::find(enemySlimes.begin(), enemySlimes.end(), effectiveSlime) - enemySlimes.begin(), 6);
+        return Action(ActionType::ChangeSlime, effectiveSlime, 6);
     }
 
     // Check if current slime is at a disadvantage
-    if (isEffectiveAgainst(playerSlime->getType(), enemySlime->getType()))
+    SlimeType activeType = team.getType(active);
+    if (TypeChart::isEffectiveAgainst(opponentType, activeType))
     {
         // Try to switch to a non-disadvantaged slime
-        for (size_t i = 0; i < enemySlimes.size(); ++i)
+        int safeSlime = team.find([&](int i)
+                                  { return team.isStanding(i) && i != active && !TypeChart::isEffectiveAgainst(opponentType, team.getType(i)); });
+        if (safeSlime >= 0)
         {
-            if (!enemySlimes[i]->isDefeated() && enemySlimes[i] != enemySlime &&
-                !isEffectiveAgainst(playerSlime->getType(), enemySlimes[i]->getType()))
-            {
-                return Action(ActionType::ChangeSlime, i, 6);
-            }
+            return Action(ActionType::ChangeSlime, safeSlime, 6);
         }
     }
 
     // If no better option, use a skill
     // the strategy follows that of task1
     // if enemy's slime has type advantage over player's slime, use skill 2, if not, use skill 1
-    if (isEffectiveAgainst(enemySlime->getType(), playerSlime->getType()))
+    return chooseSimpleSkill(activeType, opponentType);
+}
+
+/**
+ * @brief Chooses an action by the potion-greedy rules: the potions first, then the greedy rules.
+ * @details As in task2, the greedy rules switch away from a type disadvantage, but in task3 a potion that
+ * can and should be used comes first, revival before attack. A boosted slime is not switched out,
+ * it attacks by the simple rules instead. A team without potions plays exactly the greedy rules.
+ * @param team The choosing side's team.
+ * @param active The slot of its active slime.
+ * @param opponentType The type of the opponent's active slime.
+ * @return The chosen action.
+ */
+template <typename Team>
+static Action choosePotionGreedyAction(const Team &team, int active, SlimeType opponentType)
+{
+    // a revival potion heals half the max HP of a beaten slime
+    if (team.hasRevivalPotion() && team.find([&](int i)
+                                             { return !team.isStanding(i); }) >= 0)
     {
-        return Action(ActionType::UseSkill, 1, 0);
+        return Action(ActionType::UsePotion, 0, 5);
     }
-    else
+
+    // an attack potion is used when the active slime is neither at a type disadvantage nor boosted
+    SlimeType activeType = team.getType(active);
+    if (team.hasAttackPotion() && !team.isBoosted(active) && !TypeChart::isEffectiveAgainst(opponentType, activeType))
     {
-        return Action(ActionType::UseSkill, 0, 0);
+        return Action(ActionType::UsePotion, 1, 5);
     }
+
+    // If we can't or shouldn't use potions, use the greedy strategy
+    Action greedyAction = chooseGreedyAction(team, active, opponentType);
+
+    // Don't change slime if it has attack boost, fallback to simpleAI strategy
+    if (greedyAction.getType() == ActionType::ChangeSlime && team.isBoosted(active))
+    {
+        return chooseSimpleSkill(activeType, opponentType);
+    }
+    return greedyAction;
 }
 
-Slime *GreedyAIStrategy::chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine)
+/**
+ * @brief Chooses a slime to send by the greedy rules, at the start of the game or as a replacement.
+ * @param team The choosing side's team.
+ * @param opponentType The type of the opponent's active slime, or nullptr if it has none yet.
+ * @return The slot of the chosen slime.
+ */
+template <typename Team>
+static int chooseGreedySlime(const Team &team, const SlimeType *opponentType)
 {
-    // Choose a slime that is effective against the player's starting slime, if possible
-    Slime *effectiveSlime = findEffectiveSlime(slimes, engine.getPlayerActiveSlime());
-    if (effectiveSlime)
+    // Choose a slime that is effective against the opponent's active slime, if possible
+    int effectiveSlime = opponentType ? findEffectiveSlot(team, *opponentType) : -1;
+    if (effectiveSlime >= 0)
     {
         return effectiveSlime;
     }
 
     // If no effective slime, choose the first non-defeated slime
-    for (Slime *slime : slimes)
+    int standing = team.find([&](int i)
+                             { return team.isStanding(i); });
+
+    // None standing should never happen if the game is set up correctly
+    return standing >= 0 ? standing : 0;
+}
+
+Action GreedyAIStrategy::chooseAction(const Engine &engine)
+{
+    const Slime *playerSlime = getOpponentActiveSlime(engine);
+    const Slime *enemySlime = getOwnActiveSlime(engine);
+    SlimeList enemySlimes = getOwnPlayer(engine).getSlimes();
+    return chooseGreedyAction(PlayerTeamView{enemySlimes}, enemySlime->getSlot(), playerSlime->getType());
+}
+
+int GreedyAIStrategy::chooseStartingSlime(const SlimeList &slimes, const Engine &engine)
+{
+    const Slime *opponentSlime = getOpponentActiveSlime(engine);
+    if (!opponentSlime)
     {
-        if (!slime->isDefeated())
+        // nothing to counter yet, e.g. when choosing the starting slime before the opponent
+        return chooseGreedySlime(PlayerTeamView{slimes}, nullptr);
+    }
+    SlimeType opponentType = opponentSlime->getType();
+    return chooseGreedySlime(PlayerTeamView{slimes}, &opponentType);
+}
+
+int GreedyAIStrategy::chooseNextSlime(const SlimeList &slimes, const Engine &engine)
+{
+    // a replacement is chosen by the same rules as the starting slime
+    return GreedyAIStrategy::chooseStartingSlime(slimes, engine);
+}
+
+Action PotionGreedyAIStrategy::chooseAction(const Engine &engine)
+{
+    // As in task2, enemy's strategy would prioritize changing slime if it is at a type disadvantage to players current active slime
+    // But in task3, if the condition to use potions is met, ai would choose to use potion instead of changing slime.
+    // And ai would use revival instead of attack potion if both potions can be used.
+    const Player &enemyPlayer = getOwnPlayer(engine);
+    const Slime *playerSlime = getOpponentActiveSlime(engine);
+    const Slime *enemySlime = getOwnActiveSlime(engine);
+    SlimeList enemySlimes = enemyPlayer.getSlimes();
+    return choosePotionGreedyAction(PlayerTeamView{enemySlimes, &enemyPlayer}, enemySlime->getSlot(), playerSlime->getType());
+}
+
+// wider than any value, so that values of exactly -1 or 1 still count as exact
+static const double kFullWindow = 2.0;
+
+SearchAIStrategy::SearchAIStrategy(int depth, size_t tableMegabytes)
+    : depth(std::max(1, depth)), setup(), table(tableMegabytes) {}
+
+void SearchAIStrategy::reset() { table.clear(); }
+
+Action SearchAIStrategy::chooseAction(const Engine &engine)
+{
+    return withRules(engine.getRules(), [&](auto rules)
+                     { return searchAction<decltype(rules)>(engine); });
+}
+
+int SearchAIStrategy::chooseStartingSlime(const SlimeList &slimes, const Engine &engine)
+{
+    return withRules(engine.getRules(), [&](auto rules)
+                     { return searchStartingSlime<decltype(rules)>(slimes, engine); });
+}
+
+int SearchAIStrategy::chooseNextSlime(const SlimeList &slimes, const Engine &engine)
+{
+    return withRules(engine.getRules(), [&](auto rules)
+                     { return searchNextSlime<decltype(rules)>(slimes, engine); });
+}
+
+template <typename Rules>
+Action SearchAIStrategy::searchAction(const Engine &engine)
+{
+    setup = engine.getSetup();
+    BattleState state = BattleState::fromEngine(engine);
+
+    Action rows[kMaxActions];
+    Action cols[kMaxActions];
+    int rowCount = orderedActions<Rules>(state, Side::Player, rows);
+    int colCount = orderedActions<Rules>(state, Side::Enemy, cols);
+
+    // the root needs the full mixed strategy, not just a bound, so its matrix is always solved
+    MatrixGame game(rowCount, colCount);
+    fillMatrix<Rules>(state, depth, rows, cols, game);
+    game.solve();
+
+    // play our side's equilibrium strategy, a deterministic choice could be read and punished
+    const Action *actions = side == Side::Player ? rows : cols;
+    int count = side == Side::Player ? rowCount : colCount;
+    double r = rng->uniformReal();
+    for (int i = 0; i < count - 1; ++i)
+    {
+        double probability = side == Side::Player ? game.getRowStrategy(i) : game.getColStrategy(i);
+        if (r < probability)
         {
-            return slime;
+            return actions[i];
         }
+        r -= probability;
     }
+    return actions[count - 1];
+}
+
+template <typename Rules>
+int SearchAIStrategy::searchStartingSlime(const SlimeList &slimes, const Engine &engine)
+{
+    setup = engine.getSetup();
+    // HP and potions are taken from the engine, the active slimes are filled in below
+    BattleState initial = BattleState::fromEngine(engine);
+
+    const Player &opponent = getOpponent(engine);
+    SlimeList opponentSlimes = opponent.getSlimes();
+    Slime *opponentSlime = getOpponentActiveSlime(engine);
 
-    // This should never happen if the game is set up correctly
-    return slimes[0];
+    int best = -1;
+    double bestValue = -kFullWindow;
+    for (size_t i = 0; i < slimes.size(); ++i)
+    {
+        double worst = kFullWindow;
+        for (size_t j = 0; j < opponentSlimes.size(); ++j)
+        {
+            if (opponentSlime && &opponentSlimes[j] != opponentSlime)
+            {
+                continue;
+            }
+            BattleState state = initial;
+            state[side].active = static_cast<int8_t>(i);
+            state[opponentOf(side)].active = static_cast<int8_t>(j);
+            double value = search<Rules>(state, depth, -kFullWindow, kFullWindow);
+            worst = std::min(worst, side == Side::Player ? value : -value);
+        }
+        if (best < 0 || worst > bestValue)
+        {
+            best = static_cast<int>(i);
+            bestValue = worst;
+        }
+    }
+    return best >= 0 ? best : GreedyAIStrategy::chooseStartingSlime(slimes, engine);
 }
 
-Slime *GreedyAIStrategy::chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine)
+template <typename Rules>
+int SearchAIStrategy::searchNextSlime(const SlimeList &slimes, const Engine &engine)
 {
-    // First, try to find a slime effective against the player's active slime
-    Slime *effectiveSlime = findEffectiveSlime(slimes, engine.getPlayerActiveSlime());
-    if (effectiveSlime)
+    setup = engine.getSetup();
+    // the replacement is sent mid-turn, the searched position starts the next round
+    BattleState next = BattleState::fromEngine(engine);
+    next.round++;
+    if (next.round >= Rules::kRoundLimit)
     {
-        return effectiveSlime;
+        return GreedyAIStrategy::chooseNextSlime(slimes, engine);
     }
 
-    // If no effective slime, choose the first non-defeated slime
-    for (Slime *slime : slimes)
+    int best = -1;
+    double bestValue = -kFullWindow;
+    for (size_t i = 0; i < slimes.size(); ++i)
+    {
+        if (slimes[i].isDefeated())
+        {
+            continue;
+        }
+        BattleState replaced = next;
+        Engine::sendSlime(replaced, side, static_cast<int>(i));
+        double value = search<Rules>(replaced, depth, -kFullWindow, kFullWindow);
+        if (side == Side::Enemy)
+        {
+            value = -value;
+        }
+        if (best < 0 || value > bestValue)
+        {
+            best = static_cast<int>(i);
+            bestValue = value;
+        }
+    }
+    return best >= 0 ? best : GreedyAIStrategy::chooseNextSlime(slimes, engine);
+}
+
+template <typename Rules>
+double SearchAIStrategy::search(const BattleState &state, int depth, double alpha, double beta)
+{
+    // close to the round limit the value depends on the round, which the hash leaves out
+    bool cacheable = state.round + depth < Rules::kRoundLimit;
+    uint64_t key = Zobrist::hash(state);
+    int hintMove = -1;
+    TTEntry entry;
+    if (cacheable && table.probe(key, entry))
+    {
+        if (entry.depth >= depth)
+        {
+            if (entry.bound == Bound::Exact ||
+                (entry.bound == Bound::Lower && entry.value >= beta) ||
+                (entry.bound == Bound::Upper && entry.value <= alpha))
+            {
+                return entry.value;
+            }
+        }
+        hintMove = entry.bestMove;
+    }
+
+    Action rows[kMaxActions];
+    Action cols[kMaxActions];
+    int order[kMaxActions];
+    int rowCount = orderedActions<Rules>(state, Side::Player, rows);
+    int colCount = orderedActions<Rules>(state, Side::Enemy, cols);
+    for (int i = 0; i < rowCount; ++i)
     {
-        if (!slime->isDefeated())
+        order[i] = i;
+    }
+    // the best action of an earlier search of this position is tried first
+    if (hintMove > 0 && hintMove < rowCount)
+    {
+        std::rotate(rows, rows + hintMove, rows + hintMove + 1);
+        std::rotate(order, order + hintMove, order + hintMove + 1);
+    }
+
+    // the player committing first can only do worse than in the simultaneous game: a lower bound
+    int bestRow = 0;
+    double lower = searchSerialized<Rules>(state, depth, alpha, beta, true, rows, rowCount, cols, colCount, bestRow);
+    if (lower >= beta)
+    {
+        if (cacheable)
         {
-            return slime;
+            table.store(key, static_cast<float>(lower), depth, Bound::Lower, order[bestRow]);
         }
+        return lower;
     }
 
-    // This should never happen if the game is set up correctly
-    return slimes[0];
+    // and the enemy committing first gives an upper bound
+    int unused = 0;
+    double upper = searchSerialized<Rules>(state, depth, alpha, beta, false, rows, rowCount, cols, colCount, unused);
+    if (upper <= alpha)
+    {
+        if (cacheable)
+        {
+            table.store(key, static_cast<float>(upper), depth, Bound::Upper, order[bestRow]);
+        }
+        return upper;
+    }
+
+    double value;
+    if (lower > alpha && upper < beta && lower == upper)
+    {
+        // both bounds are exact and meet: a pure saddle point, no matrix to solve
+        value = lower;
+    }
+    else
+    {
+        MatrixGame game(rowCount, colCount);
+        fillMatrix<Rules>(state, depth, rows, cols, game);
+        value = game.solve();
+        for (int i = 1; i < rowCount; ++i)
+        {
+            if (game.getRowStrategy(i) > game.getRowStrategy(bestRow))
+            {
+                bestRow = i;
+            }
+        }
+    }
+
+    if (cacheable)
+    {
+        table.store(key, static_cast<float>(value), depth, Bound::Exact, order[bestRow]);
+    }
+    return value;
 }
 
-Action PotionGreedyAIStrategy::chooseAction(const Engine &engine)
+template <typename Rules>
+void SearchAIStrategy::fillMatrix(const BattleState &state, int depth, const Action *rows, const Action *cols, MatrixGame &game)
 {
-    // As in task2, enemy's strategy would prioritize changing slime if it is at a type disadvantage to players current active slime
-    // But in task3, if the condition to use potions is met, ai would choose to use potion instead of changing slime.
-    // And ai would use revival instead of attack potion if both potions can be used.
+    // the equilibrium can mix actions whose values lie anywhere, so every entry is searched exactly
+    for (int i = 0; i < game.getRows(); ++i)
+    {
+        for (int j = 0; j < game.getCols(); ++j)
+        {
+            game.set(i, j, searchTurn<Rules>(state, depth, rows[i], cols[j], -kFullWindow, kFullWindow));
+        }
+    }
+}
 
-    const Player &enemyPlayer = engine.getEnemy();
-    const Slime *playerSlime = engine.getPlayerActiveSlime();
-    const Slime *enemySlime = engine.getEnemyActiveSlime();
-    const std::vector<Slime *> &enemySlimes = enemyPlayer.getSlimes();
+template <typename Rules>
+double SearchAIStrategy::searchSerialized(const BattleState &state, int depth, double alpha, double beta, bool playerFirst,
+                                          const Action *rows, int rowCount, const Action *cols, int colCount, int &bestRow)
+{
+    int firstCount = playerFirst ? rowCount : colCount;
+    int replyCount = playerFirst ? colCount : rowCount;
+    double best = playerFirst ? -kFullWindow : kFullWindow;
+    bestRow = 0;
 
-    // Check if we can and should use Revival Potion
-    if (enemyPlayer.canUseRevivalPotion() && shouldUseRevivalPotion(enemyPlayer))
+    for (int f = 0; f < firstCount; ++f)
     {
-        return Action(ActionType::UsePotion, 0, 5);
+        // the side replying sees the first action and picks its best answer
+        double replyAlpha = playerFirst ? std::max(alpha, best) : alpha;
+        double replyBeta = playerFirst ? beta : std::min(beta, best);
+        double reply = playerFirst ? kFullWindow : -kFullWindow;
+        for (int r = 0; r < replyCount; ++r)
+        {
+            double value = searchTurn<Rules>(state, depth, playerFirst ? rows[f] : rows[r], playerFirst ? cols[r] : cols[f], replyAlpha, replyBeta);
+            if (playerFirst)
+            {
+                reply = std::min(reply, value);
+                replyBeta = std::min(replyBeta, value);
+            }
+            else
+            {
+                reply = std::max(reply, value);
+                replyAlpha = std::max(replyAlpha, value);
+            }
+            if (replyAlpha >= replyBeta)
+            {
+                break;
+            }
+        }
+
+        if (playerFirst ? reply > best : reply < best)
+        {
+            best = reply;
+            if (playerFirst)
+            {
+                bestRow = f;
+            }
+        }
+        if (playerFirst ? best >= beta : best <= alpha)
+        {
+            break;
+        }
     }
+    return best;
+}
 
-    // Check if we can and should use Attack Potion
-    if (enemyPlayer.canUseAttackPotion() && shouldUseAttackPotion(enemySlime, playerSlime))
+template <typename Rules>
+double SearchAIStrategy::searchTurn(const BattleState &state, int depth, const Action &playerAction, const Action &enemyAction,
+                                    double alpha, double beta)
+{
+    TurnOutcome outcomes[kMaxOutcomes];
+    double probabilities[kMaxOutcomes];
+    int count = Engine::listOutcomes(state, setup, playerAction, enemyAction, outcomes, probabilities);
+    if (count == 1)
     {
-        return Action(ActionType::UsePotion, 1, 5);
+        BattleState next = state;
+        Engine::executeTurn<Rules>(next, setup, playerAction, enemyAction, outcomes[0]);
+        return searchAfterTurn<Rules>(next, depth - 1, alpha, beta);
     }
 
-    // If we can't or shouldn't use potions, use the greedy strategy
-    Action greedyAction = GreedyAIStrategy::chooseAction(engine);
+    double value = 0.0;
+    for (int k = 0; k < count; ++k)
+    {
+        BattleState next = state;
+        Engine::executeTurn<Rules>(next, setup, playerAction, enemyAction, outcomes[k]);
+        value += probabilities[k] * searchAfterTurn<Rules>(next, depth - 1, -kFullWindow, kFullWindow);
+    }
+    return value;
+}
 
-    // Don't change slime if it has attack boost, fallback to simpleAI strategy
-    if (greedyAction.getType() == ActionType::ChangeSlime && enemySlime->isAttackBoosted())
+template <typename Rules>
+double SearchAIStrategy::searchAfterTurn(const BattleState &state, int depth, double alpha, double beta)
+{
+    if (Engine::isDefeated(state, Side::Player))
+    {
+        return -1.0;
+    }
+    if (Engine::isDefeated(state, Side::Enemy))
+    {
+        return 1.0;
+    }
+    if (state.round >= Rules::kRoundLimit)
     {
-        Action simpleAction = SimpleAIStrategy::chooseAction(engine);
-        return simpleAction;
+        return 0.0;
+    }
+    if (depth <= 0)
+    {
+        return evaluate(state);
     }
 
-    return greedyAction;
+    BattleState next = state;
+    next.round++;
+
+    // at most one slime is beaten per turn, its side picks the replacement that is best for it
+    for (Side replacing : {Side::Player, Side::Enemy})
+    {
+        const SideState &own = state[replacing];
+        if (own.hp[own.active] > 0)
+        {
+            continue;
+        }
+        bool maximize = replacing == Side::Player;
+        double best = maximize ? -kFullWindow : kFullWindow;
+        for (int i = 0; i < setup.getTeamSize(replacing); ++i)
+        {
+            if (own.hp[i] == 0)
+            {
+                continue;
+            }
+            BattleState replaced = next;
+            Engine::sendSlime(replaced, replacing, i);
+            double value = search<Rules>(replaced, depth, alpha, beta);
+            if (maximize)
+            {
+                best = std::max(best, value);
+                alpha = std::max(alpha, value);
+            }
+            else
+            {
+                best = std::min(best, value);
+                beta = std::min(beta, value);
+            }
+            if (alpha >= beta)
+            {
+                break;
+            }
+        }
+        return best;
+    }
+    return search<Rules>(next, depth, alpha, beta);
+}
+
+double SearchAIStrategy::evaluate(const BattleState &state) const
+{
+    double fraction[2];
+    for (Side s : {Side::Player, Side::Enemy})
+    {
+        int hp = 0;
+        int maxHP = 0;
+        for (int i = 0; i < setup.getTeamSize(s); ++i)
+        {
+            hp += state[s].hp[i];
+            maxHP += setup.getSpecies(s, i).maxHP;
+        }
+        fraction[sideIndex(s)] = maxHP > 0 ? double(hp) / maxHP : 0.0;
+    }
+    // kept clear of -1 and 1, which are reserved for finished games
+    return 0.9 * (fraction[0] - fraction[1]);
+}
+
+template <typename Rules>
+int SearchAIStrategy::orderedActions(const BattleState &state, Side side, Action *actions) const
+{
+    int count = Engine::listActions<Rules>(state, setup, side, actions);
+    const SideState &own = state[side];
+    const SideState &other = state[opponentOf(side)];
+
+    // skills by the damage they deal, which puts super-effective ones first, then everything else as listed
+    auto score = [&](const Action &action)
+    {
+        if (action.getType() != ActionType::UseSkill)
+        {
+            return -1;
+        }
+        return setup.getDamage(side, own.active, action.getIndex(), other.active, own.boosted);
+    };
+    // a stable insertion sort: the lists are a handful of actions long, and std::stable_sort would allocate a buffer at every node
+    int scores[kMaxActions];
+    for (int i = 0; i < count; ++i)
+    {
+        scores[i] = score(actions[i]);
+    }
+    for (int i = 1; i < count; ++i)
+    {
+        Action action = actions[i];
+        int actionScore = scores[i];
+        int j = i;
+        for (; j > 0 && scores[j - 1] < actionScore; --j)
+        {
+            actions[j] = actions[j - 1];
+            scores[j] = scores[j - 1];
+        }
+        actions[j] = action;
+        scores[j] = actionScore;
+    }
+    return count;
+}
+
+// exploration constant of UCB1, for values scaled to [0, 1]
+static const double kExploration = 0.7;
+
+MCTSStrategy::MCTSStrategy(int iterations, long long microseconds)
+    : iterations(std::max(1, iterations)), microseconds(microseconds), setup()
+{
+    // a playout adds at most one node and the tree is cleared between decisions, so an iteration budget
+    // never needs more room than this and decisions don't allocate; a time budget may still grow the tree
+    nodes.reserve(this->iterations + 1);
+    path.reserve(kRoundLimit);
+}
+
+void MCTSStrategy::reset()
+{
+    nodes.clear();
+    simulatedTurns = 0;
+}
+
+Action MCTSStrategy::chooseAction(const Engine &engine)
+{
+    return withRules(engine.getRules(), [&](auto rules)
+                     { return searchAction<decltype(rules)>(engine); });
+}
+
+template <typename Rules>
+Action MCTSStrategy::searchAction(const Engine &engine)
+{
+    setup = engine.getSetup();
+    nodes.clear();
+    addNode<Rules>(BattleState::fromEngine(engine));
+
+    if (microseconds > 0)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(microseconds);
+        // check the clock every few playouts only, a playout takes about as long as reading it
+        do
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                playout<Rules>();
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+    }
+    else
+    {
+        for (int i = 0; i < iterations; ++i)
+        {
+            playout<Rules>();
+        }
+    }
+
+    // the most visited action is the most robust choice, the exploration term keeps the visit counts of weak actions low
+    const Node &root = nodes[0];
+    int s = sideIndex(side);
+    int best = 0;
+    for (int i = 1; i < root.actionCount[s]; ++i)
+    {
+        if (root.visits[s][i] > root.visits[s][best])
+        {
+            best = i;
+        }
+    }
+    return root.actions[s][best];
+}
+
+template <typename Rules>
+int MCTSStrategy::addNode(const BattleState &state)
+{
+    nodes.emplace_back();
+    Node &node = nodes.back();
+    node.state = state;
+    for (Side s : {Side::Player, Side::Enemy})
+    {
+        int index = sideIndex(s);
+        node.actionCount[index] = Engine::listActions<Rules>(state, setup, s, node.actions[index]);
+        std::fill(node.visits[index], node.visits[index] + kMaxActions, 0);
+        std::fill(node.values[index], node.values[index] + kMaxActions, 0.0);
+    }
+    node.totalVisits = 0;
+    std::fill(&node.children[0][0][0], &node.children[0][0][0] + kMaxActions * kMaxActions * kMaxOutcomes, -1);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+template <typename Rules>
+void MCTSStrategy::playout()
+{
+    path.clear();
+    int current = 0;
+    double value;
+
+    // selection: walk down while both sides' choices lead to a known node
+    while (true)
+    {
+        int playerChoice = selectAction(nodes[current], Side::Player);
+        int enemyChoice = selectAction(nodes[current], Side::Enemy);
+        path.push_back(PathStep{current, {playerChoice, enemyChoice}});
+
+        // the outcome is drawn before looking for the child, each outcome has a child of its own
+        BattleState next = nodes[current].state;
+        int outcome = playTurn<Rules>(next, nodes[current].actions[0][playerChoice], nodes[current].actions[1][enemyChoice]);
+        int child = nodes[current].children[playerChoice][enemyChoice][outcome];
+        if (child >= 0)
+        {
+            current = child;
+            continue;
+        }
+
+        if (finishTurn<Rules>(next))
+        {
+            value = Engine::getResult(next) == GameResult::Win ? 1.0 : Engine::getResult(next) == GameResult::Lose ? -1.0 : 0.0;
+            break;
+        }
+
+        // expansion and rollout, addNode may move the nodes so the parent is looked up again
+        child = addNode<Rules>(next);
+        nodes[current].children[playerChoice][enemyChoice][outcome] = child;
+        value = rollout<Rules>(next);
+        break;
+    }
+
+    // backpropagation, each side's statistics are kept from its own point of view
+    for (const PathStep &step : path)
+    {
+        Node &node = nodes[step.node];
+        node.totalVisits++;
+        node.visits[0][step.choice[0]]++;
+        node.values[0][step.choice[0]] += value;
+        node.visits[1][step.choice[1]]++;
+        node.values[1][step.choice[1]] -= value;
+    }
+}
+
+int MCTSStrategy::selectAction(const Node &node, Side side) const
+{
+    int s = sideIndex(side);
+    int best = 0;
+    double bestScore = -1.0;
+    double logVisits = std::log(static_cast<double>(node.totalVisits) + 1.0);
+    for (int i = 0; i < node.actionCount[s]; ++i)
+    {
+        if (node.visits[s][i] == 0)
+        {
+            return i;
+        }
+        // the mean value is scaled from [-1, 1] to [0, 1]
+        double mean = (node.values[s][i] / node.visits[s][i] + 1.0) / 2.0;
+        double score = mean + kExploration * std::sqrt(logVisits / node.visits[s][i]);
+        if (score > bestScore)
+        {
+            best = i;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+template <typename Rules>
+bool MCTSStrategy::finishTurn(BattleState &state) const
+{
+    if (Engine::isGameOver<Rules>(state))
+    {
+        return true;
+    }
+    for (Side s : {Side::Player, Side::Enemy})
+    {
+        if (state[s].hp[state[s].active] == 0)
+        {
+            Engine::sendSlime(state, s, rolloutReplacement(state, s));
+        }
+    }
+    state.round++;
+    return false;
 }
 
-bool PotionGreedyAIStrategy::shouldUseRevivalPotion(const Player &player)
+template <typename Rules>
+int MCTSStrategy::playTurn(BattleState &state, const Action &playerAction, const Action &enemyAction)
 {
-    return std::any_of(player.getSlimes().begin(), player.getSlimes().end(),
-                       [](const Slime *s)
-                       { return s->isDefeated(); });
+    TurnOutcome outcomes[kMaxOutcomes];
+    double probabilities[kMaxOutcomes];
+    int count = Engine::listOutcomes(state, setup, playerAction, enemyAction, outcomes, probabilities);
+    int outcome = 0;
+    if (count > 1)
+    {
+        double draw = rng->uniformReal();
+        while (outcome < count - 1 && draw >= probabilities[outcome])
+        {
+            draw -= probabilities[outcome++];
+        }
+    }
+    Engine::executeTurn<Rules>(state, setup, playerAction, enemyAction, outcomes[outcome]);
+    simulatedTurns++;
+    return outcome;
 }
 
-bool PotionGreedyAIStrategy::shouldUseAttackPotion(const Slime *enemySlime, const Slime *playerSlime)
+template <typename Rules>
+double MCTSStrategy::rollout(BattleState state)
 {
-    return !enemySlime->isAttackBoosted() && !isEffectiveAgainst(playerSlime->getType(), enemySlime->getType());
-}
\ No newline at end of file
+    while (true)
+    {
+        playTurn<Rules>(state, rolloutAction<Rules>(state, Side::Player), rolloutAction<Rules>(state, Side::Enemy));
+        if (finishTurn<Rules>(state))
+        {
+            GameResult result = Engine::getResult(state);
+            return result == GameResult::Win ? 1.0 : result == GameResult::Lose ? -1.0 : 0.0;
+        }
+    }
+}
+
+template <typename Rules>
+Action MCTSStrategy::rolloutAction(const BattleState &state, Side side) const
+{
+    SlimeType opponentType = setup.getSpecies(opponentOf(side), state[opponentOf(side)].active).type;
+    if constexpr (Rules::kPotions)
+    {
+        return choosePotionGreedyAction(StateTeamView{state, setup, side}, state[side].active, opponentType);
+    }
+    else
+    {
+        return chooseGreedyAction(StateTeamView{state, setup, side}, state[side].active, opponentType);
+    }
+}
+
+int MCTSStrategy::rolloutReplacement(const BattleState &state, Side side) const
+{
+    SlimeType opponentType = setup.getSpecies(opponentOf(side), state[opponentOf(side)].active).type;
+    return chooseGreedySlime(StateTeamView{state, setup, side}, &opponentType);
+}
+
+Strategy *createStrategy(const std::string &name)
+{
+    if (name == "simple")
+    {
+        return new SimpleAIStrategy();
+    }
+    if (name == "greedy")
+    {
+        return new GreedyAIStrategy();
+    }
+    if (name == "potion-greedy")
+    {
+        return new PotionGreedyAIStrategy();
+    }
+    if (name == "search")
+    {
+        return new SearchAIStrategy();
+    }
+    if (name == "mcts")
+    {
+        return new MCTSStrategy();
+    }
+    return nullptr;
+}
@@ -1,9 +1,15 @@
 #pragma once
+#include <string>
 #include <vector>
 #include "action.h"
 #include "slime.h"
+#include "side.h"
+#include "battle_state.h"
+#include "transposition.h"
 
 class Engine;
+class MatrixGame;
+class Rng;
 class Slime;
 class Player;
 
@@ -31,19 +37,77 @@ public:
 
     /**
      * @brief Chooses a starting slime at the beginning of the game.
-     * @param slimes Vector of available slimes to choose from.
+     * @param slimes The available slimes to choose from.
      * @param engine Reference to the game engine containing the current state.
-     * @return Pointer to the chosen starting Slime.
+     * @return Index of the chosen starting slime in slimes.
      */
-    virtual Slime *chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine) = 0;
+    virtual int chooseStartingSlime(const SlimeList &slimes, const Engine &engine) = 0;
 
     /**
      * @brief Chooses the next slime when a switch is necessary.
-     * @param slimes Vector of available slimes to choose from.
+     * @param slimes The available slimes to choose from.
      * @param engine Reference to the game engine containing the current state.
-     * @return Pointer to the chosen next Slime.
+     * @return Index of the chosen next slime in slimes, or -1 for none.
      */
-    virtual Slime *chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine) = 0;
+    virtual int chooseNextSlime(const SlimeList &slimes, const Engine &engine) = 0;
+
+    /**
+     * @brief Gets the name of the strategy, as accepted by createStrategy.
+     * @return The name, a string literal.
+     */
+    virtual const char *getName() const = 0;
+
+    /**
+     * @brief Forgets everything learned during a game, so a reused strategy plays like a new one.
+     * @details Called by Player::reset. Strategies without such state need not override it.
+     */
+    virtual void reset() {}
+
+    /**
+     * @brief Sets the side this strategy is playing for.
+     * @details Called by the Engine, so the same strategy can play either side in bot-vs-bot games.
+     * @param side The side this strategy is playing for.
+     */
+    void setSide(Side side);
+
+    /**
+     * @brief Sets the random number generator this strategy draws from.
+     * @details Called by the Engine, so every random choice of a game comes from that game's stream.
+     * @param rng The generator, it must outlive the strategy's use of it.
+     */
+    void setRng(Rng &rng);
+
+protected:
+    /**
+     * @brief Gets the player this strategy is deciding for.
+     * @param engine Reference to the game engine containing the current state.
+     * @return Const reference to the strategy's own player.
+     */
+    const Player &getOwnPlayer(const Engine &engine) const;
+
+    /**
+     * @brief Gets the player this strategy is playing against.
+     * @param engine Reference to the game engine containing the current state.
+     * @return Const reference to the opposing player.
+     */
+    const Player &getOpponent(const Engine &engine) const;
+
+    /**
+     * @brief Gets the strategy's own active slime.
+     * @param engine Reference to the game engine containing the current state.
+     * @return Pointer to the own active slime (nullptr before it is chosen).
+     */
+    Slime *getOwnActiveSlime(const Engine &engine) const;
+
+    /**
+     * @brief Gets the opposing player's active slime.
+     * @param engine Reference to the game engine containing the current state.
+     * @return Pointer to the opposing active slime (nullptr before it is chosen).
+     */
+    Slime *getOpponentActiveSlime(const Engine &engine) const;
+
+    Side side = Side::Enemy; /**< The side this strategy is playing for */
+    Rng *rng = nullptr;      /**< The generator of random choices, set by the Engine */
 };
 
 /**
@@ -58,16 +122,17 @@ class HumanStrategy : public Strategy
 private:
     /**
      * @brief Helper method to choose the index of the next slime.
-     * @param slimes Vector of available slimes to choose from.
+     * @param slimes The available slimes to choose from.
      * @param activeSlime Pointer to the currently active slime.
-     * @return Index of the chosen slime in the slimes vector.
+     * @return Index of the chosen slime in slimes.
      */
-    int chooseNextSlimeIndex(const std::vector<Slime *> &slimes, Slime *activeSlime);
+    int chooseNextSlimeIndex(const SlimeList &slimes, Slime *activeSlime);
 
 public:
     Action chooseAction(const Engine &engine) override;
-    Slime *chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine) override;
-    Slime *chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine) override;
+    const char *getName() const override { return "human"; }
+    int chooseStartingSlime(const SlimeList &slimes, const Engine &engine) override;
+    int chooseNextSlime(const SlimeList &slimes, const Engine &engine) override;
 };
 
 /**
@@ -81,8 +146,9 @@ class SimpleAIStrategy : public Strategy
 {
 public:
     Action chooseAction(const Engine &engine) override;
-    Slime *chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine) override;
-    Slime *chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine) override;
+    const char *getName() const override { return "simple"; }
+    int chooseStartingSlime(const SlimeList &slimes, const Engine &engine) override;
+    int chooseNextSlime(const SlimeList &slimes, const Engine &engine) override;
 };
 
 /**
@@ -96,47 +162,341 @@ class GreedyAIStrategy : public SimpleAIStrategy
 {
 public:
     Action chooseAction(const Engine &engine) override;
-    Slime *chooseStartingSlime(const std::vector<Slime *> &slimes, const Engine &engine) override;
-    Slime *chooseNextSlime(const std::vector<Slime *> &slimes, const Engine &engine) override;
+    const char *getName() const override { return "greedy"; }
+    int chooseStartingSlime(const SlimeList &slimes, const Engine &engine) override;
+    int chooseNextSlime(const SlimeList &slimes, const Engine &engine) override;
+};
+
+class PotionGreedyAIStrategy : public GreedyAIStrategy
+{
+public:
+    Action chooseAction(const Engine &engine) override;
+    const char *getName() const override { return "potion-greedy"; }
+};
 
-protected:
+/**
+ * @class SearchAIStrategy
+ * @brief Concrete strategy class for an AI player that searches ahead.
+ *
+ * Every turn is a simultaneous move, so at each node of the search both sides' actions
+ * (every skill, every switch to a standing slime, every useful potion) form a payoff
+ * matrix whose entries are the values of the resulting positions, and the node's value
+ * is the matrix game's mixed equilibrium. The search runs on BattleState copies to a fixed
+ * depth, where positions are scored by remaining HP. Before filling a node's matrix, the
+ * two serialized games where one side commits first are searched with plain alpha-beta:
+ * they bound the node's value from both sides, so nodes outside the (alpha, beta) window
+ * and nodes with a pure saddle point are settled without solving the matrix. The
+ * strongest skills, super-effective ones first, are ordered first so the bounds tighten
+ * early, and results are cached in a transposition table keyed by Zobrist hash. The search
+ * plays by the engine's rule set, see Engine::getRules, and is compiled once per rule set.
+ */
+class SearchAIStrategy : public GreedyAIStrategy
+{
+public:
     /**
-     * @brief Checks if one slime type is effective against another.
-     * @param attackerType The type of the attacking slime.
-     * @param defenderType The type of the defending slime.
-     * @return true if the attacker is effective against the defender, false otherwise.
+     * @brief Constructs a new SearchAIStrategy.
+     * @param depth Number of turns to search ahead.
+     * @param tableMegabytes Size of the transposition table.
      */
-    bool isEffectiveAgainst(SlimeType attackerType, SlimeType defenderType) const;
+    explicit SearchAIStrategy(int depth = 3, size_t tableMegabytes = 4);
+
+    Action chooseAction(const Engine &engine) override;
+    const char *getName() const override { return "search"; }
+
+    /**
+     * @brief Clears the transposition table.
+     */
+    void reset() override;
+
+    /**
+     * @brief Chooses the starting slime that does best against the opponent's starting slime.
+     * @details When the opponent has not chosen yet, every answer of theirs is assumed and the
+     * slime whose worst matchup is best is chosen.
+     */
+    int chooseStartingSlime(const SlimeList &slimes, const Engine &engine) override;
+    int chooseNextSlime(const SlimeList &slimes, const Engine &engine) override;
 
 private:
+    int depth;                /**< Number of turns to search ahead */
+    BattleSetup setup;        /**< Static data of the battle being searched */
+    TranspositionTable table; /**< Cache of searched positions */
+
+    /**
+     * @brief Chooses an action as chooseAction does, under the engine's rule set.
+     * @tparam Rules The rule set the engine plays by, see Engine::getRules.
+     * @param engine The engine.
+     * @return The chosen action.
+     */
+    template <typename Rules>
+    Action searchAction(const Engine &engine);
+
+    /**
+     * @brief Chooses the starting slime as chooseStartingSlime does, under the engine's rule set.
+     * @tparam Rules The rule set the engine plays by, see Engine::getRules.
+     * @param slimes The slimes to choose from.
+     * @param engine The engine.
+     * @return The index of the chosen slime.
+     */
+    template <typename Rules>
+    int searchStartingSlime(const SlimeList &slimes, const Engine &engine);
+
+    /**
+     * @brief Chooses the replacement slime as chooseNextSlime does, under the engine's rule set.
+     * @tparam Rules The rule set the engine plays by, see Engine::getRules.
+     * @param slimes The slimes to choose from.
+     * @param engine The engine.
+     * @return The index of the chosen slime.
+     */
+    template <typename Rules>
+    int searchNextSlime(const SlimeList &slimes, const Engine &engine);
+
+    /**
+     * @brief Searches a start-of-turn position.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position, both active slimes standing.
+     * @param depth Remaining number of turns to search.
+     * @param alpha Lower end of the search window.
+     * @param beta Upper end of the search window.
+     * @return The value of the position for the player, between -1 and 1.
+     */
+    template <typename Rules>
+    double search(const BattleState &state, int depth, double alpha, double beta);
+
+    /**
+     * @brief Values the position reached at the end of a turn, handling finished games and forced replacements.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position right after Engine::executeTurn.
+     * @param depth Remaining number of turns to search.
+     * @param alpha Lower end of the search window.
+     * @param beta Upper end of the search window.
+     * @return The value of the position for the player.
+     */
+    template <typename Rules>
+    double searchAfterTurn(const BattleState &state, int depth, double alpha, double beta);
+
+    /**
+     * @brief Values a pair of actions, averaging over the turn's chance outcomes.
+     * @details A turn with a single outcome is searched within the given window. With misses or
+     * critical hits each outcome is searched exactly, as an expectation cannot be cut by a window.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position at the start of the turn.
+     * @param depth Remaining number of turns to search, counting this one.
+     * @param playerAction The player's action.
+     * @param enemyAction The enemy's action.
+     * @param alpha Lower end of the search window.
+     * @param beta Upper end of the search window.
+     * @return The value of the pair of actions for the player.
+     */
+    template <typename Rules>
+    double searchTurn(const BattleState &state, int depth, const Action &playerAction, const Action &enemyAction,
+                      double alpha, double beta);
+
     /**
-     * @brief Finds a slime that is effective against the given slime.
-     * @param slimes Vector of available slimes to choose from.
-     * @param targetSlime The slime to find an effective counter for.
-     * @return Pointer to an effective slime if found, nullptr otherwise.
+     * @brief Fills the payoff matrix of a node with the exact values of all its children.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position.
+     * @param depth Remaining number of turns to search, counting this one.
+     * @param rows The player's actions.
+     * @param cols The enemy's actions.
+     * @param game Receives the payoffs, its size gives the number of actions of each side.
      */
-    Slime *findEffectiveSlime(const std::vector<Slime *> &slimes, const Slime *targetSlime) const;
+    template <typename Rules>
+    void fillMatrix(const BattleState &state, int depth, const Action *rows, const Action *cols, MatrixGame &game);
+
+    /**
+     * @brief Bounds a node by letting one side commit to a pure action first, searched with plain alpha-beta.
+     * @details With the player committing first this is the maximin of the node, a lower bound on its
+     * value; with the enemy committing first it is the minimax, an upper bound.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position.
+     * @param depth Remaining number of turns to search.
+     * @param alpha Lower end of the search window.
+     * @param beta Upper end of the search window.
+     * @param playerFirst Whether the player commits first.
+     * @param rows The player's actions.
+     * @param rowCount Number of player actions.
+     * @param cols The enemy's actions.
+     * @param colCount Number of enemy actions.
+     * @param bestRow Receives the player action of the bound when the player commits first.
+     * @return The bound, fail-soft with respect to the window.
+     */
+    template <typename Rules>
+    double searchSerialized(const BattleState &state, int depth, double alpha, double beta, bool playerFirst,
+                            const Action *rows, int rowCount, const Action *cols, int colCount, int &bestRow);
+
+    /**
+     * @brief Scores a position at the search horizon by the remaining HP of both teams.
+     * @param state The position.
+     * @return The estimated value for the player, strictly between -1 and 1.
+     */
+    double evaluate(const BattleState &state) const;
+
+    /**
+     * @brief Lists a side's actions, super-effective skills first.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position.
+     * @param side The side choosing an action.
+     * @param actions Receives the actions, room for kMaxActions entries.
+     * @return The number of actions.
+     */
+    template <typename Rules>
+    int orderedActions(const BattleState &state, Side side, Action *actions) const;
 };
 
-class PotionGreedyAIStrategy : public GreedyAIStrategy
+/**
+ * @class MCTSStrategy
+ * @brief Concrete strategy class for an AI player that plans by Monte Carlo Tree Search.
+ *
+ * The tree is searched with decoupled UCT: every node keeps separate visit and value
+ * statistics for the player's and the enemy's actions, and each side picks its own action
+ * by UCB1 as if the other side were part of the environment. New nodes are valued by a
+ * headless rollout to the end of the game in which both sides follow the PotionGreedyAIStrategy
+ * rules, or the GreedyAIStrategy rules under rules without potions, whose replacement rule is
+ * also used for forced replacements inside the tree. Turns with misses or critical hits
+ * draw their chance outcome, each outcome leading to a child of its own. The tree and the rollouts
+ * play by the engine's rule set, see Engine::getRules. Rollouts run millions of turns
+ * through Engine::executeTurn, so the strategy doubles as a turn throughput benchmark.
+ */
+class MCTSStrategy : public GreedyAIStrategy
 {
 public:
+    /**
+     * @brief Constructs a new MCTSStrategy.
+     * @param iterations Number of playouts per decision, used when no time budget is given.
+     * @param microseconds Time budget per decision in microseconds, 0 to use the iteration budget instead.
+     */
+    explicit MCTSStrategy(int iterations = 1000, long long microseconds = 0);
+
     Action chooseAction(const Engine &engine) override;
+    const char *getName() const override { return "mcts"; }
+
+    /**
+     * @brief Clears the tree and the count of simulated turns.
+     */
+    void reset() override;
+
+    /**
+     * @brief Gets the number of turns simulated so far, in the tree and in rollouts.
+     * @return The number of calls to Engine::executeTurn made by this strategy.
+     */
+    long long getSimulatedTurns() const { return simulatedTurns; }
 
 private:
     /**
-     * @brief Checks if the player should use a revival potion.
-     * @details Player will use a revival potion to heal half the max HP of an inactive defeated slime.
-     * @param player The player object.
-     * @return true if the player should use a revival potion, false otherwise.
+     * @brief A position in the search tree, at the start of a turn.
+     */
+    struct Node
+    {
+        BattleState state;                              /**< The position */
+        int actionCount[2];                             /**< Number of actions of each side */
+        Action actions[2][kMaxActions];                 /**< Actions of each side */
+        int visits[2][kMaxActions];                     /**< Times each side chose each action here */
+        double values[2][kMaxActions];                  /**< Summed playout values of each action, for the side choosing it */
+        int totalVisits;                                /**< Times the node was visited */
+        int children[kMaxActions][kMaxActions][kMaxOutcomes]; /**< Node reached by each pair of actions and chance outcome, or -1 */
+    };
+
+    /**
+     * @brief One step of the path from the root to a new node.
+     */
+    struct PathStep
+    {
+        int node;          /**< Index of the node */
+        int choice[2];     /**< Action chosen by each side */
+    };
+
+    int iterations;                 /**< Playouts per decision */
+    long long microseconds;         /**< Time budget per decision, 0 for none */
+    long long simulatedTurns = 0;   /**< Turns simulated so far */
+    BattleSetup setup;              /**< Static data of the battle being searched */
+    std::vector<Node> nodes;        /**< The tree, nodes[0] is the root */
+    std::vector<PathStep> path;     /**< The path of the current playout */
+
+    /**
+     * @brief Chooses an action as chooseAction does, under the engine's rule set.
+     * @tparam Rules The rule set the engine plays by, see Engine::getRules.
+     * @param engine The engine.
+     * @return The chosen action.
+     */
+    template <typename Rules>
+    Action searchAction(const Engine &engine);
+
+    /**
+     * @brief Adds a node to the tree.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position of the node.
+     * @return The index of the new node.
+     */
+    template <typename Rules>
+    int addNode(const BattleState &state);
+
+    /**
+     * @brief Runs one playout: selection, expansion, rollout and backpropagation.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     */
+    template <typename Rules>
+    void playout();
 
+    /**
+     * @brief Picks the action of one side at a node by UCB1, untried actions first.
+     * @param node The node.
+     * @param side The side choosing.
+     * @return The index of the action.
      */
-    bool shouldUseRevivalPotion(const Player &player);
+    int selectAction(const Node &node, Side side) const;
+
     /**
-     * @brief Checks if the player should use an attack potion.
-     * @details Enemy will use attack potion when the current active slime is not at type disadvantage and is not attack boosted.
-     * @param enemySlime The enemy slime object.
-     * @return true if the player should use an attack potion, false otherwise.
+     * @brief Finishes a turn as the engine does: ends the game, or sends the replacement and starts the next round.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position right after Engine::executeTurn.
+     * @return true if the game is over, false otherwise.
      */
-    bool shouldUseAttackPotion(const Slime *enemySlime, const Slime *playerSlime);
-};
\ No newline at end of file
+    template <typename Rules>
+    bool finishTurn(BattleState &state) const;
+
+    /**
+     * @brief Plays a turn, drawing its chance outcome when there is more than one.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position at the start of the turn, updated to the position right after it.
+     * @param playerAction The player's action.
+     * @param enemyAction The enemy's action.
+     * @return The index of the outcome drawn, in the order of Engine::listOutcomes.
+     */
+    template <typename Rules>
+    int playTurn(BattleState &state, const Action &playerAction, const Action &enemyAction);
+
+    /**
+     * @brief Plays a position to the end with both sides following the rollout policy.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position, at the start of a turn.
+     * @return The result for the player: 1 for a win, -1 for a loss, 0 for a draw.
+     */
+    template <typename Rules>
+    double rollout(BattleState state);
+
+    /**
+     * @brief Chooses a side's action by the rollout policy, directly on a battle state.
+     * @details The PotionGreedyAIStrategy rules under rules with potions, the GreedyAIStrategy rules otherwise.
+     * @tparam Rules The rule set searched, the one the engine plays by.
+     * @param state The position.
+     * @param side The side choosing.
+     * @return The chosen action.
+     */
+    template <typename Rules>
+    Action rolloutAction(const BattleState &state, Side side) const;
+
+    /**
+     * @brief Chooses a side's replacement slime by the GreedyAIStrategy rules, directly on a battle state.
+     * @param state The position, the side's active slime beaten.
+     * @param side The side choosing.
+     * @return The index of the chosen slime.
+     */
+    int rolloutReplacement(const BattleState &state, Side side) const;
+};
+
+/**
+ * @brief Creates an AI strategy from its command line name.
+ * @param name One of "simple", "greedy", "potion-greedy", "search" or "mcts".
+ * @return Pointer to a newly allocated Strategy, or nullptr if the name is unknown.
+ */
+Strategy *createStrategy(const std::string &name);
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+
+// The shape of the teams, fixed at compile time by the Makefile's TEAM_SIZE and SKILL_COUNT.
+// 0 leaves it to the rosters: teams of up to kDynamicMaxTeamSize slimes, slimes of up to kDynamicMaxSkillCount skills.
+#ifndef SLIME_TEAM_SIZE
+#define SLIME_TEAM_SIZE 0
+#endif
+#ifndef SLIME_SKILL_COUNT
+#define SLIME_SKILL_COUNT 0
+#endif
+
+constexpr int kFixedTeamSize = SLIME_TEAM_SIZE;   /**< Slimes in every team, 0 when teams may differ */
+constexpr int kFixedSkillCount = SLIME_SKILL_COUNT; /**< Skills of every slime, 0 when slimes may differ */
+constexpr int kDynamicMaxTeamSize = 6;   /**< Most slimes a team can have when the team size is not fixed */
+constexpr int kDynamicMaxSkillCount = 2; /**< Most skills a slime can have when the skill count is not fixed, as many as a species knows (see speciesSkills) */
+
+static_assert(kFixedTeamSize >= 0 && kFixedSkillCount >= 0, "SLIME_TEAM_SIZE and SLIME_SKILL_COUNT must not be negative");
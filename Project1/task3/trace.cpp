@@ -0,0 +1,92 @@
+#include "trace.h"
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const std::chrono::steady_clock::time_point Trace::epoch = std::chrono::steady_clock::now();
+
+/**
+ * @brief A finished span.
+ */
+struct TraceEvent
+{
+    const char *name;   /**< Name of the span */
+    const char *detail; /**< Detail shown with the span, or nullptr */
+    uint64_t start;     /**< When the span started, in nanoseconds on the trace clock */
+    uint64_t duration;  /**< How long the span lasted, in nanoseconds */
+};
+
+/**
+ * @brief The spans of one thread, the oldest overwritten once it is full.
+ */
+struct TraceBuffer
+{
+    int thread;                     /**< Number of the thread, in order of first span */
+    std::vector<TraceEvent> events; /**< The spans, kBufferCapacity once full */
+    size_t next = 0;                /**< Where the next span goes once the buffer is full */
+};
+
+// buffers are owned here rather than by their threads, so the spans of finished threads can still be exported
+static std::mutex buffersMutex;
+static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+/**
+ * @brief Gets the calling thread's buffer, registering it on first use.
+ */
+static TraceBuffer &threadBuffer()
+{
+    thread_local TraceBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::make_unique<TraceBuffer>());
+        buffer = buffers.back().get();
+        buffer->thread = static_cast<int>(buffers.size());
+        buffer->events.reserve(Trace::kBufferCapacity);
+    }
+    return *buffer;
+}
+
+void Trace::record(const char *name, const char *detail, uint64_t start, uint64_t end)
+{
+    TraceBuffer &buffer = threadBuffer();
+    TraceEvent event{name, detail, start, end - start};
+    if (buffer.events.size() < kBufferCapacity)
+    {
+        buffer.events.push_back(event);
+        return;
+    }
+    buffer.events[buffer.next] = event;
+    buffer.next = (buffer.next + 1) % kBufferCapacity;
+}
+
+size_t Trace::writeJson(std::ostream &out)
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    size_t written = 0;
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    for (const std::unique_ptr<TraceBuffer> &buffer : buffers)
+    {
+        // oldest first, which is from next onwards once the buffer has wrapped
+        size_t count = buffer->events.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const TraceEvent &event = buffer->events[(buffer->next + i) % count];
+            out << (written++ ? ",\n" : "") << "{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->thread
+                << ", \"ts\": " << event.start / 1000.0 << ", \"dur\": " << event.duration / 1000.0;
+            if (event.detail)
+            {
+                out << ", \"args\": {\"detail\": \"" << event.detail << "\"}";
+            }
+            out << "}";
+        }
+    }
+    out << "\n]}" << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+    return written;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @class Trace
+ * @brief Collects timed spans of the battle into per-thread ring buffers and exports them as Chrome trace events.
+ *
+ * Spans are opened with the TRACE_SPAN macro, which compiles to nothing unless SLIME_TRACE is
+ * defined (make TRACE=1), so spans can stay in every build. Each thread writes to its own
+ * buffer without locking; when a buffer is full the oldest spans are overwritten, so a long
+ * run keeps its most recent kBufferCapacity spans per thread. The file written by writeJson
+ * opens in chrome://tracing or Perfetto.
+ */
+class Trace
+{
+public:
+    static constexpr size_t kBufferCapacity = 1 << 16; /**< Spans kept per thread */
+
+    /**
+     * @brief Checks whether spans are recorded in this build.
+     * @return true if the program was compiled with SLIME_TRACE, false otherwise.
+     */
+    static constexpr bool isEnabled()
+    {
+#ifdef SLIME_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Gets the current time on the trace clock.
+     * @return Nanoseconds since the trace clock started.
+     */
+    static uint64_t now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    /**
+     * @brief Records a finished span in the calling thread's buffer.
+     * @param name Name of the span, a string literal.
+     * @param detail Optional detail shown with the span, a string literal or nullptr.
+     * @param start When the span started, from now().
+     * @param end When the span ended, from now().
+     */
+    static void record(const char *name, const char *detail, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Writes the spans of every thread as a Chrome trace-event JSON document.
+     * @details Must not run while other threads are still recording, e.g. call it after joining them.
+     * @param out The stream to write to.
+     * @return The number of spans written.
+     */
+    static size_t writeJson(std::ostream &out);
+
+private:
+    static const std::chrono::steady_clock::time_point epoch; /**< Start of the trace clock */
+};
+
+/**
+ * @class TraceSpan
+ * @brief Records the time between its construction and its destruction as a span, see TRACE_SPAN.
+ */
+class TraceSpan
+{
+public:
+    /**
+     * @brief Opens a span.
+     * @param name Name of the span, a string literal.
+     * @param detail Optional detail shown with the span, a string literal or nullptr.
+     */
+    explicit TraceSpan(const char *name, const char *detail = nullptr) : name(name), detail(detail), start(Trace::now()) {}
+
+    /**
+     * @brief Closes the span and records it.
+     */
+    ~TraceSpan() { Trace::record(name, detail, start, Trace::now()); }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name;   /**< Name of the span */
+    const char *detail; /**< Detail shown with the span, or nullptr */
+    uint64_t start;     /**< When the span started */
+};
+
+#define SLIME_TRACE_CONCAT_INNER(a, b) a##b
+#define SLIME_TRACE_CONCAT(a, b) SLIME_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Times the rest of the enclosing scope as a span: TRACE_SPAN("name") or TRACE_SPAN("name", detail).
+ */
+#ifdef SLIME_TRACE
+#define TRACE_SPAN(...) TraceSpan SLIME_TRACE_CONCAT(traceSpan, __LINE__)(__VA_ARGS__)
+#else
+#define TRACE_SPAN(...) ((void)0)
+#endif
@@ -0,0 +1,65 @@
+#include "transposition.h"
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+    size_t wanted = megabytes * 1024 * 1024 / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= wanted)
+    {
+        count *= 2;
+    }
+    buckets.resize(count);
+    mask = count - 1;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry &entry) const
+{
+    const Bucket &bucket = buckets[key & mask];
+    for (const TTEntry &candidate : bucket.entries)
+    {
+        if (candidate.bound != Bound::None && candidate.key == key)
+        {
+            entry = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, float value, int depth, Bound bound, int bestMove)
+{
+    Bucket &bucket = buckets[key & mask];
+    TTEntry *target = nullptr;
+    for (TTEntry &candidate : bucket.entries)
+    {
+        if (candidate.bound != Bound::None && candidate.key == key)
+        {
+            // keep a deeper result of the same position
+            if (depth < candidate.depth)
+            {
+                return;
+            }
+            target = &candidate;
+            break;
+        }
+        if (!target || candidate.depth < target->depth)
+        {
+            // empty entries have depth -1, so they are picked before any stored one
+            target = &candidate;
+        }
+    }
+
+    target->key = key;
+    target->value = value;
+    target->depth = static_cast<int8_t>(depth);
+    target->bound = bound;
+    target->bestMove = static_cast<int8_t>(bestMove);
+}
+
+void TranspositionTable::clear()
+{
+    for (Bucket &bucket : buckets)
+    {
+        bucket = Bucket();
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief What a stored search value says about the true value of a position.
+ */
+enum class Bound : uint8_t
+{
+    None,  /**< The entry is empty */
+    Exact, /**< The value is exact */
+    Lower, /**< The true value is at least the stored value (the search failed high) */
+    Upper  /**< The true value is at most the stored value (the search failed low) */
+};
+
+/**
+ * @brief One transposition table entry.
+ */
+struct TTEntry
+{
+    uint64_t key = 0;          /**< Full Zobrist hash of the position, to tell apart positions sharing a bucket */
+    float value = 0.0f;        /**< Value of the position for the player */
+    int8_t depth = -1;         /**< Depth the value was searched to */
+    Bound bound = Bound::None; /**< What kind of value is stored */
+    int8_t bestMove = -1;      /**< Index of the best action found for the side to search, or -1 */
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed-size, bucketed cache of search results keyed by Zobrist hash.
+ *
+ * The table never grows: the hash picks a bucket of kBucketSize entries, and a new
+ * result goes into the entry of the same position, an empty entry, or else the
+ * entry searched to the lowest depth (depth-preferred replacement), so deep and
+ * expensive results survive longer than shallow ones.
+ */
+class TranspositionTable
+{
+public:
+    static constexpr int kBucketSize = 4; /**< Number of entries per bucket */
+
+    /**
+     * @brief Constructs a new TranspositionTable.
+     * @param megabytes Approximate memory budget, rounded down to a power-of-two number of buckets.
+     */
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    /**
+     * @brief Looks up a position.
+     * @param key The Zobrist hash of the position.
+     * @param entry Receives the stored entry if the position is found.
+     * @return true if the position is in the table, false otherwise.
+     */
+    bool probe(uint64_t key, TTEntry &entry) const;
+
+    /**
+     * @brief Stores a search result.
+     * @param key The Zobrist hash of the position.
+     * @param value The value found.
+     * @param depth The depth the position was searched to.
+     * @param bound What kind of value it is.
+     * @param bestMove Index of the best action found, or -1.
+     */
+    void store(uint64_t key, float value, int depth, Bound bound, int bestMove);
+
+    /**
+     * @brief Empties the table.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief A group of entries sharing the same index bits, sized to a cache line.
+     */
+    struct alignas(64) Bucket
+    {
+        TTEntry entries[kBucketSize];
+    };
+
+    std::vector<Bucket> buckets; /**< The table, its size is a power of two */
+    uint64_t mask;               /**< Mask selecting a bucket from a hash */
+};
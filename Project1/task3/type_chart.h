@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include "skill.h"
+#include "slime.h"
+
+constexpr int kSkillTypeCount = static_cast<int>(SkillType::Count); /**< Number of skill types */
+constexpr int kSlimeTypeCount = static_cast<int>(SlimeType::Count); /**< Number of slime types */
+
+/**
+ * @brief Effectiveness of a skill type against a slime type, in halves: 1 is half damage, 2 normal damage, 4 double damage.
+ */
+struct Matchup
+{
+    SkillType skill;    /**< The type of the attacking skill */
+    SlimeType defender; /**< The type of the defending slime */
+    int halves;         /**< The damage multiplier, in halves */
+};
+
+/**
+ * @brief Every matchup that is not normal damage. Adding a type only needs its enumerators and its rows here.
+ */
+inline constexpr Matchup kMatchups[] = {
+    {SkillType::Grass, SlimeType::Water, 4},
+    {SkillType::Fire, SlimeType::Grass, 4},
+    {SkillType::Water, SlimeType::Fire, 4},
+    {SkillType::Grass, SlimeType::Fire, 1},
+    {SkillType::Fire, SlimeType::Water, 1},
+    {SkillType::Water, SlimeType::Grass, 1},
+    {SkillType::Grass, SlimeType::Grass, 1},
+    {SkillType::Fire, SlimeType::Fire, 1},
+    {SkillType::Water, SlimeType::Water, 1},
+};
+
+/**
+ * @brief The skill type of every slime type's own skill, used to tell which slime has the upper hand over which.
+ */
+inline constexpr SkillType kSlimeSkillTypes[kSlimeTypeCount] = {
+    SkillType::Grass, // SlimeType::Grass
+    SkillType::Fire,  // SlimeType::Fire
+    SkillType::Water, // SlimeType::Water
+};
+
+/**
+ * @brief The full type chart, see TypeChart.
+ */
+struct TypeChartTables
+{
+    uint8_t halves[kSkillTypeCount][kSlimeTypeCount]; /**< Effectiveness of every skill type against every slime type, in halves */
+    bool effective[kSlimeTypeCount][kSlimeTypeCount];  /**< Whether a slime type's own skill is super effective against another slime type */
+};
+
+/**
+ * @brief Expands the compact matchup list into the full chart, every unlisted matchup being normal damage.
+ * @return The chart tables.
+ */
+constexpr TypeChartTables generateTypeChart()
+{
+    TypeChartTables chart = {};
+    for (int s = 0; s < kSkillTypeCount; ++s)
+    {
+        for (int d = 0; d < kSlimeTypeCount; ++d)
+        {
+            chart.halves[s][d] = 2;
+        }
+    }
+    for (const Matchup &matchup : kMatchups)
+    {
+        chart.halves[static_cast<int>(matchup.skill)][static_cast<int>(matchup.defender)] = static_cast<uint8_t>(matchup.halves);
+    }
+    for (int a = 0; a < kSlimeTypeCount; ++a)
+    {
+        for (int d = 0; d < kSlimeTypeCount; ++d)
+        {
+            chart.effective[a][d] = chart.halves[static_cast<int>(kSlimeSkillTypes[a])][d] > 2;
+        }
+    }
+    return chart;
+}
+
+inline constexpr TypeChartTables kTypeChart = generateTypeChart(); /**< The chart, computed by the compiler */
+
+/**
+ * @class TypeChart
+ * @brief Type effectiveness lookups, each a single load from a table built at compile time.
+ */
+class TypeChart
+{
+public:
+    /**
+     * @brief Gets the effectiveness of a skill type against a slime type, in halves.
+     * @return 1 for half damage, 2 for normal damage, 4 for double damage.
+     */
+    static constexpr int halves(SkillType skill, SlimeType defender)
+    {
+        return kTypeChart.halves[static_cast<int>(skill)][static_cast<int>(defender)];
+    }
+
+    /**
+     * @brief Gets the damage multiplier of a skill type against a slime type.
+     * @return 0.5, 1 or 2.
+     */
+    static constexpr float effectiveness(SkillType skill, SlimeType defender) { return halves(skill, defender) * 0.5f; }
+
+    /**
+     * @brief Checks if a slime type's own skill is super effective against another slime type.
+     * @return true if the attacker has the type advantage, false otherwise.
+     */
+    static constexpr bool isEffectiveAgainst(SlimeType attacker, SlimeType defender)
+    {
+        return kTypeChart.effective[static_cast<int>(attacker)][static_cast<int>(defender)];
+    }
+};
+
+static_assert(TypeChart::halves(SkillType::Water, SlimeType::Fire) == 4, "water beats fire");
+static_assert(TypeChart::isEffectiveAgainst(SlimeType::Grass, SlimeType::Water), "grass beats water");
+static_assert(!TypeChart::isEffectiveAgainst(SlimeType::Fire, SlimeType::Water), "fire does not beat water");
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include "battle_state.h"
+
+constexpr int kZobristMaxHP = 255;     /**< Highest HP value with its own Zobrist key */
+constexpr int kZobristMaxPotions = 7;  /**< Highest potion count with its own Zobrist key */
+
+/**
+ * @brief Every Zobrist key, see Zobrist.
+ */
+struct ZobristKeys
+{
+    uint64_t hp[2][kMaxTeamSize][kZobristMaxHP + 1];
+    uint64_t active[2][kMaxTeamSize];
+    uint64_t boosted[2][kMaxTeamSize];
+    uint64_t revival[2][kZobristMaxPotions + 1];
+    uint64_t attack[2][kZobristMaxPotions + 1];
+};
+
+/**
+ * @brief Fills the keys from a fixed-seed SplitMix64 sequence, so hashes are the same in every build.
+ * @return The key tables.
+ */
+constexpr ZobristKeys generateZobristKeys()
+{
+    ZobristKeys keys = {};
+    uint64_t seed = 0x51A1EB0B5EEDULL;
+    auto next = [&seed]() {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (int s = 0; s < 2; ++s)
+    {
+        for (int i = 0; i < kMaxTeamSize; ++i)
+        {
+            for (int h = 0; h <= kZobristMaxHP; ++h)
+            {
+                keys.hp[s][i][h] = next();
+            }
+            keys.active[s][i] = next();
+            keys.boosted[s][i] = next();
+        }
+        for (int c = 0; c <= kZobristMaxPotions; ++c)
+        {
+            keys.revival[s][c] = next();
+            keys.attack[s][c] = next();
+        }
+    }
+    return keys;
+}
+
+inline constexpr ZobristKeys kZobristKeys = generateZobristKeys(); /**< The key tables, computed by the compiler */
+
+/**
+ * @class Zobrist
+ * @brief 64-bit Zobrist keys for battle positions.
+ *
+ * A position's hash is the XOR of one random key per feature: the HP of every slime,
+ * the active slime, the boosted slime and the unused potion counts of both sides. The
+ * round is left out, so positions reached by different move orders (switching back and
+ * forth is common) hash the same. Because every key is XORed in, a change of one
+ * feature updates the hash by XORing out the old key and XORing in the new one, which is
+ * what Slime and Player do as the battle goes on.
+ */
+class Zobrist
+{
+public:
+    /**
+     * @brief Gets the key of a slime's HP value.
+     */
+    static uint64_t hp(Side side, int slot, int hp) { return kZobristKeys.hp[sideIndex(side)][slot][hp]; }
+
+    /**
+     * @brief Gets the key of a slime being active.
+     */
+    static uint64_t active(Side side, int slot) { return kZobristKeys.active[sideIndex(side)][slot]; }
+
+    /**
+     * @brief Gets the key of a slime's attack being boosted.
+     */
+    static uint64_t boosted(Side side, int slot) { return kZobristKeys.boosted[sideIndex(side)][slot]; }
+
+    /**
+     * @brief Gets the key of a side's number of unused revival potions.
+     */
+    static uint64_t revivalPotions(Side side, int count) { return kZobristKeys.revival[sideIndex(side)][count]; }
+
+    /**
+     * @brief Gets the key of a side's number of unused attack potions.
+     */
+    static uint64_t attackPotions(Side side, int count) { return kZobristKeys.attack[sideIndex(side)][count]; }
+
+    /**
+     * @brief Computes the hash of a battle state from scratch.
+     * @param state The battle state.
+     * @return The same hash the Engine's players maintain incrementally for that position.
+     */
+    static uint64_t hash(const BattleState &state)
+    {
+        uint64_t hash = 0;
+        for (Side side : {Side::Player, Side::Enemy})
+        {
+            const SideState &own = state[side];
+            for (int i = 0; i < kMaxTeamSize; ++i)
+            {
+                hash ^= Zobrist::hp(side, i, own.hp[i]);
+            }
+            hash ^= active(side, own.active);
+            if (own.boosted)
+            {
+                hash ^= boosted(side, own.active);
+            }
+            hash ^= revivalPotions(side, own.revivalPotions) ^ attackPotions(side, own.attackPotions);
+        }
+        return hash;
+    }
+};